@@ -228,18 +228,66 @@ int main() {
         });
     });
     
+    server.Post("/api/risk/assess/batch", [](const httplib::Request& req, httplib::Response& res) {
+        g_middlewareChain.execute(req, res, [&req](const httplib::Request&, httplib::Response& res) {
+            forwardRequest(req, res, "risk-assessment-service", "/assess-risk/batch");
+        });
+    });
+    
+    server.Post("/api/risk/assess/rescore", [](const httplib::Request& req, httplib::Response& res) {
+        g_middlewareChain.execute(req, res, [&req](const httplib::Request&, httplib::Response& res) {
+            forwardRequest(req, res, "risk-assessment-service", "/assess-risk/rescore");
+        });
+    });
+    
     server.Post("/api/risk/cluster", [](const httplib::Request& req, httplib::Response& res) {
         g_middlewareChain.execute(req, res, [&req](const httplib::Request&, httplib::Response& res) {
             forwardRequest(req, res, "risk-assessment-service", "/cluster/borrowers");
         });
     });
     
+    server.Post("/api/risk/cluster/segments", [](const httplib::Request& req, httplib::Response& res) {
+        g_middlewareChain.execute(req, res, [&req](const httplib::Request&, httplib::Response& res) {
+            forwardRequest(req, res, "risk-assessment-service", "/cluster/borrowers/segments");
+        });
+    });
+    
     server.Get("/api/risk/model/status", [](const httplib::Request& req, httplib::Response& res) {
         g_middlewareChain.execute(req, res, [&req](const httplib::Request&, httplib::Response& res) {
             forwardRequest(req, res, "risk-assessment-service", "/model/status");
         });
     });
     
+    server.Get("/api/risk/model/importances", [](const httplib::Request& req, httplib::Response& res) {
+        g_middlewareChain.execute(req, res, [&req](const httplib::Request&, httplib::Response& res) {
+            forwardRequest(req, res, "risk-assessment-service", "/model/importances");
+        });
+    });
+    
+    server.Get("/api/risk/model/precision", [](const httplib::Request& req, httplib::Response& res) {
+        g_middlewareChain.execute(req, res, [&req](const httplib::Request&, httplib::Response& res) {
+            forwardRequest(req, res, "risk-assessment-service", "/model/precision");
+        });
+    });
+    
+    server.Post("/api/risk/model/precision", [](const httplib::Request& req, httplib::Response& res) {
+        g_middlewareChain.execute(req, res, [&req](const httplib::Request&, httplib::Response& res) {
+            forwardRequest(req, res, "risk-assessment-service", "/model/precision");
+        });
+    });
+    
+    server.Get("/api/risk/cache/stats", [](const httplib::Request& req, httplib::Response& res) {
+        g_middlewareChain.execute(req, res, [&req](const httplib::Request&, httplib::Response& res) {
+            forwardRequest(req, res, "risk-assessment-service", "/cache/stats");
+        });
+    });
+    
+    server.Post("/api/risk/model/reload", [](const httplib::Request& req, httplib::Response& res) {
+        g_middlewareChain.execute(req, res, [&req](const httplib::Request&, httplib::Response& res) {
+            forwardRequest(req, res, "risk-assessment-service", "/model/reload");
+        });
+    });
+    
     // Route /api/strategy/* to recovery-strategy-service
     server.Get("/api/strategy/list", [](const httplib::Request& req, httplib::Response& res) {
         g_middlewareChain.execute(req, res, [&req](const httplib::Request&, httplib::Response& res) {
@@ -5,6 +5,7 @@
 
 #include <vector>
 #include <optional>
+#include <span>
 #include <string>
 #include "../models/PaymentHistory.h"
 #include "../../../common/include/database/DatabaseManager.h"
@@ -73,6 +74,13 @@ public:
      */
     std::vector<PaymentHistory> findByAccountId(int accountId);
     
+    /**
+     * @brief Find all payments for several loan accounts in one round trip
+     * @param accountIds Loan account IDs
+     * @return Payments grouped by account in the order given, each group ordered by payment_date DESC
+     */
+    std::vector<PaymentHistory> findByAccountIds(std::span<const int> accountIds);
+    
     /**
      * @brief Find payments by status
      * @param status Payment status to filter
@@ -158,6 +166,7 @@ private:
     PaymentHistory createMock(const PaymentHistory& payment);
     std::optional<PaymentHistory> findByIdMock(int paymentId);
     std::vector<PaymentHistory> findByAccountIdMock(int accountId);
+    std::vector<PaymentHistory> findByAccountIdsMock(std::span<const int> accountIds);
     std::vector<PaymentHistory> findAllMock();
 };
 
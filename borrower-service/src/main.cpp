@@ -531,12 +531,13 @@ int main() {
             // Get all loan accounts for this borrower
             auto loans = loanRepo.findByBorrowerId(borrowerId);
             
-            // Collect payments from all loan accounts
-            std::vector<PaymentHistory> allPayments;
+            // Collect payments from all loan accounts in one round trip
+            std::vector<int> accountIds;
+            accountIds.reserve(loans.size());
             for (const auto& loan : loans) {
-                auto payments = paymentRepo.findByAccountId(loan.getAccountId());
-                allPayments.insert(allPayments.end(), payments.begin(), payments.end());
+                accountIds.push_back(loan.getAccountId());
             }
+            auto allPayments = paymentRepo.findByAccountIds(accountIds);
             
             // Convert to JSON
             json j = json::array();
@@ -8,6 +8,77 @@
 namespace sdrs::borrower
 {
 
+namespace
+{
+
+const sdrs::database::PreparedStatement CREATE("borrower_create", R"(
+    INSERT INTO borrowers (
+        first_name, last_name, email, phone_number,
+        date_of_birth, address,
+        monthly_income, employment_status, is_active
+    ) VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9)
+    RETURNING borrower_id, created_at, updated_at
+)");
+
+const sdrs::database::PreparedStatement FIND_BY_ID("borrower_find_by_id", R"(
+    SELECT borrower_id, first_name, last_name, email, phone_number,
+           date_of_birth, address,
+           monthly_income, employment_status, risk_segment, is_active, inactive_reason,
+           created_at, updated_at
+    FROM borrowers
+    WHERE borrower_id = $1
+)");
+
+const sdrs::database::PreparedStatement UPDATE("borrower_update", R"(
+    UPDATE borrowers SET
+        first_name = $2,
+        last_name = $3,
+        email = $4,
+        phone_number = $5,
+        address = $6,
+        monthly_income = $7,
+        employment_status = $8::employment_status_enum,
+        is_active = $9,
+        risk_segment = $10
+    WHERE borrower_id = $1
+    RETURNING borrower_id
+)");
+
+const sdrs::database::PreparedStatement DELETE_BY_ID("borrower_delete_by_id", "DELETE FROM borrowers WHERE borrower_id = $1");
+
+const sdrs::database::PreparedStatement FIND_ALL("borrower_find_all", R"(
+    SELECT borrower_id, first_name, last_name, email, phone_number,
+           date_of_birth, address,
+           monthly_income, employment_status, risk_segment, is_active, inactive_reason,
+           created_at, updated_at
+    FROM borrowers
+    ORDER BY created_at DESC
+    LIMIT 100
+)");
+
+const sdrs::database::PreparedStatement FIND_BY_EMAIL("borrower_find_by_email", R"(
+    SELECT borrower_id, first_name, last_name, email, phone_number,
+           date_of_birth, address,
+           monthly_income, employment_status, risk_segment, is_active, inactive_reason,
+           created_at, updated_at
+    FROM borrowers
+    WHERE email = $1
+)");
+
+const sdrs::database::PreparedStatement FIND_BY_ACTIVE_STATUS("borrower_find_by_active_status", R"(
+    SELECT borrower_id, first_name, last_name, email, phone_number,
+           date_of_birth, address,
+           monthly_income, employment_status, risk_segment, is_active, inactive_reason,
+           created_at, updated_at
+    FROM borrowers
+    WHERE is_active = $1
+    ORDER BY created_at DESC
+)");
+
+const sdrs::database::PreparedStatement COUNT("borrower_count", "SELECT COUNT(*) FROM borrowers");
+
+}
+
 BorrowerRepository::BorrowerRepository(bool useMock)
     : _useMock(useMock)
 {
@@ -26,16 +97,7 @@ Borrower BorrowerRepository::create(const Borrower& borrower)
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
         return db.executeQuery([&](pqxx::work& txn) -> Borrower {
-            std::string sql = R"(
-                INSERT INTO borrowers (
-                    first_name, last_name, email, phone_number,
-                    date_of_birth, address,
-                    monthly_income, employment_status, is_active
-                ) VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9)
-                RETURNING borrower_id, created_at, updated_at
-            )";
-            
-            pqxx::result result = txn.exec_params(sql,
+            pqxx::result result = db.execPrepared(txn, CREATE,
                 borrower.getFirstName(),
                 borrower.getLastName(),
                 borrower.getEmail(),
@@ -82,17 +144,9 @@ std::optional<Borrower> BorrowerRepository::findById(int id)
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
+        // Stays on the primary: /update-segment writes the borrower read here straight back
         return db.executeQuery([&](pqxx::work& txn) -> std::optional<Borrower> {
-            std::string sql = R"(
-                SELECT borrower_id, first_name, last_name, email, phone_number,
-                       date_of_birth, address,
-                       monthly_income, employment_status, risk_segment, is_active, inactive_reason,
-                       created_at, updated_at
-                FROM borrowers
-                WHERE borrower_id = $1
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, id);
+            pqxx::result result = db.execPrepared(txn, FIND_BY_ID, id);
             
             if (result.empty())
             {
@@ -132,22 +186,7 @@ Borrower BorrowerRepository::update(const Borrower& borrower)
             sdrs::utils::Logger::Info("[DB] BEFORE UPDATE: borrower_id=" + std::to_string(borrower.getId()) + 
                                       ", risk_segment='" + riskSegmentStr + "'");
             
-            std::string sql = R"(
-                UPDATE borrowers SET
-                    first_name = $2,
-                    last_name = $3,
-                    email = $4,
-                    phone_number = $5,
-                    address = $6,
-                    monthly_income = $7,
-                    employment_status = $8::employment_status_enum,
-                    is_active = $9,
-                    risk_segment = $10
-                WHERE borrower_id = $1
-                RETURNING borrower_id
-            )";
-            
-            pqxx::result result = txn.exec_params(sql,
+            pqxx::result result = db.execPrepared(txn, UPDATE,
                 borrower.getId(),
                 borrower.getFirstName(),
                 borrower.getLastName(),
@@ -186,8 +225,7 @@ bool BorrowerRepository::deleteById(int id)
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
         return db.executeQuery([&](pqxx::work& txn) -> bool {
-            std::string sql = "DELETE FROM borrowers WHERE borrower_id = $1";
-            pqxx::result result = txn.exec_params(sql, id);
+            pqxx::result result = db.execPrepared(txn, DELETE_BY_ID, id);
             
             bool deleted = result.affected_rows() > 0;
             if (deleted)
@@ -212,18 +250,8 @@ std::vector<Borrower> BorrowerRepository::findAll()
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
-        return db.executeQuery([&](pqxx::work& txn) -> std::vector<Borrower> {
-            std::string sql = R"(
-                SELECT borrower_id, first_name, last_name, email, phone_number,
-                       date_of_birth, address,
-                       monthly_income, employment_status, risk_segment, is_active, inactive_reason,
-                       created_at, updated_at
-                FROM borrowers
-                ORDER BY created_at DESC
-                LIMIT 100
-            )";
-            
-            pqxx::result result = txn.exec(sql);
+        return db.executeRead([&](pqxx::nontransaction& txn) -> std::vector<Borrower> {
+            pqxx::result result = db.execPrepared(txn, FIND_ALL);
             
             std::vector<Borrower> borrowers;
             borrowers.reserve(result.size());
@@ -256,17 +284,8 @@ std::optional<Borrower> BorrowerRepository::findByEmail(const std::string& email
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
-        return db.executeQuery([&](pqxx::work& txn) -> std::optional<Borrower> {
-            std::string sql = R"(
-                SELECT borrower_id, first_name, last_name, email, phone_number,
-                       date_of_birth, address,
-                       monthly_income, employment_status, risk_segment, is_active, inactive_reason,
-                       created_at, updated_at
-                FROM borrowers
-                WHERE email = $1
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, email);
+        return db.executeRead([&](pqxx::nontransaction& txn) -> std::optional<Borrower> {
+            pqxx::result result = db.execPrepared(txn, FIND_BY_EMAIL, email);
             
             if (result.empty())
             {
@@ -291,18 +310,8 @@ std::vector<Borrower> BorrowerRepository::findByActiveStatus(bool isActive)
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
-        return db.executeQuery([&](pqxx::work& txn) -> std::vector<Borrower> {
-            std::string sql = R"(
-                SELECT borrower_id, first_name, last_name, email, phone_number,
-                       date_of_birth, address,
-                       monthly_income, employment_status, risk_segment, is_active, inactive_reason,
-                       created_at, updated_at
-                FROM borrowers
-                WHERE is_active = $1
-                ORDER BY created_at DESC
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, isActive);
+        return db.executeRead([&](pqxx::nontransaction& txn) -> std::vector<Borrower> {
+            pqxx::result result = db.execPrepared(txn, FIND_BY_ACTIVE_STATUS, isActive);
             
             std::vector<Borrower> borrowers;
             borrowers.reserve(result.size());
@@ -330,8 +339,8 @@ int BorrowerRepository::count()
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
-        return db.executeQuery([&](pqxx::work& txn) -> int {
-            pqxx::result result = txn.exec("SELECT COUNT(*) FROM borrowers");
+        return db.executeRead([&](pqxx::nontransaction& txn) -> int {
+            pqxx::result result = db.execPrepared(txn, COUNT);
             return result[0][0].as<int>();
         });
     }
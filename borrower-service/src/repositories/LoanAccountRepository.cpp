@@ -8,6 +8,106 @@
 namespace sdrs::borrower
 {
 
+namespace
+{
+
+const sdrs::database::PreparedStatement CREATE("loan_account_create", R"(
+    INSERT INTO loan_accounts (
+        borrower_id, loan_amount, initial_amount, interest_rate,
+        remaining_amount, loan_start_date, loan_end_date,
+        account_status, days_past_due, number_of_missed_payments
+    ) VALUES ($1, $2, $3, $4, $5, $6, $7, $8::account_status_enum, $9, $10)
+    RETURNING account_id, created_at, updated_at
+)");
+
+const sdrs::database::PreparedStatement FIND_BY_ID("loan_account_find_by_id", R"(
+    SELECT account_id, borrower_id, loan_amount, initial_amount,
+           interest_rate, remaining_amount, loan_start_date, loan_end_date,
+           account_status, days_past_due, number_of_missed_payments,
+           created_at, updated_at
+    FROM loan_accounts
+    WHERE account_id = $1
+)");
+
+const sdrs::database::PreparedStatement UPDATE("loan_account_update", R"(
+    UPDATE loan_accounts SET
+        remaining_amount = $2,
+        account_status = $3::account_status_enum,
+        days_past_due = $4,
+        number_of_missed_payments = $5
+    WHERE account_id = $1
+    RETURNING account_id
+)");
+
+const sdrs::database::PreparedStatement DELETE_BY_ID("loan_account_delete_by_id", "DELETE FROM loan_accounts WHERE account_id = $1");
+
+const sdrs::database::PreparedStatement FIND_BY_BORROWER_ID("loan_account_find_by_borrower_id", R"(
+    SELECT account_id, borrower_id, loan_amount, initial_amount,
+           interest_rate, remaining_amount, loan_start_date, loan_end_date,
+           account_status, days_past_due, number_of_missed_payments,
+           created_at, updated_at
+    FROM loan_accounts
+    WHERE borrower_id = $1
+    ORDER BY created_at DESC
+)");
+
+const sdrs::database::PreparedStatement FIND_BY_STATUS("loan_account_find_by_status", R"(
+    SELECT account_id, borrower_id, loan_amount, initial_amount,
+           interest_rate, remaining_amount, loan_start_date, loan_end_date,
+           account_status, days_past_due, number_of_missed_payments,
+           created_at, updated_at
+    FROM loan_accounts
+    WHERE account_status = $1::account_status_enum
+    ORDER BY days_past_due DESC
+)");
+
+const sdrs::database::PreparedStatement FIND_DELINQUENT("loan_account_find_delinquent", R"(
+    SELECT account_id, borrower_id, loan_amount, initial_amount,
+           interest_rate, remaining_amount, loan_start_date, loan_end_date,
+           account_status, days_past_due, number_of_missed_payments,
+           created_at, updated_at
+    FROM loan_accounts
+    WHERE days_past_due >= $1
+      AND account_status NOT IN ('PaidOff', 'ChargedOff', 'Settled')
+    ORDER BY days_past_due DESC
+)");
+
+const sdrs::database::PreparedStatement FIND_ALL("loan_account_find_all", R"(
+    SELECT account_id, borrower_id, loan_amount, initial_amount,
+           interest_rate, remaining_amount, loan_start_date, loan_end_date,
+           account_status, days_past_due, number_of_missed_payments,
+           created_at, updated_at
+    FROM loan_accounts
+    ORDER BY created_at DESC
+    LIMIT 100
+)");
+
+const sdrs::database::PreparedStatement COUNT("loan_account_count", "SELECT COUNT(*) FROM loan_accounts");
+
+const sdrs::database::PreparedStatement UPDATE_STATUS("loan_account_update_status", R"(
+    UPDATE loan_accounts 
+    SET account_status = $2::account_status_enum
+    WHERE account_id = $1
+)");
+
+const sdrs::database::PreparedStatement UPDATE_DAYS_PAST_DUE("loan_account_update_days_past_due", R"(
+    UPDATE loan_accounts 
+    SET days_past_due = $2
+    WHERE account_id = $1
+)");
+
+const sdrs::database::PreparedStatement RECORD_PAYMENT("loan_account_record_payment", R"(
+    UPDATE loan_accounts 
+    SET remaining_amount = remaining_amount - $2,
+        account_status = CASE 
+            WHEN remaining_amount - $2 <= 0 THEN 'PaidOff'::account_status_enum
+            ELSE account_status
+        END
+    WHERE account_id = $1 AND remaining_amount >= $2
+)");
+
+}
+
 LoanAccountRepository::LoanAccountRepository(bool useMock)
     : _useMock(useMock)
 {
@@ -26,16 +126,7 @@ LoanAccount LoanAccountRepository::create(const LoanAccount& account)
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
         return db.executeQuery([&](pqxx::work& txn) -> LoanAccount {
-            std::string sql = R"(
-                INSERT INTO loan_accounts (
-                    borrower_id, loan_amount, initial_amount, interest_rate,
-                    remaining_amount, loan_start_date, loan_end_date,
-                    account_status, days_past_due, number_of_missed_payments
-                ) VALUES ($1, $2, $3, $4, $5, $6, $7, $8::account_status_enum, $9, $10)
-                RETURNING account_id, created_at, updated_at
-            )";
-            
-            pqxx::result result = txn.exec_params(sql,
+            pqxx::result result = db.execPrepared(txn, CREATE,
                 account.getBorrowerId(),
                 account.getLoanAmount().getAmount(),
                 account.getInitialAmount().getAmount(),
@@ -79,17 +170,9 @@ std::optional<LoanAccount> LoanAccountRepository::findById(int accountId)
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
+        // Stays on the primary: the payment handlers update the balance read here
         return db.executeQuery([&](pqxx::work& txn) -> std::optional<LoanAccount> {
-            std::string sql = R"(
-                SELECT account_id, borrower_id, loan_amount, initial_amount,
-                       interest_rate, remaining_amount, loan_start_date, loan_end_date,
-                       account_status, days_past_due, number_of_missed_payments,
-                       created_at, updated_at
-                FROM loan_accounts
-                WHERE account_id = $1
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, accountId);
+            pqxx::result result = db.execPrepared(txn, FIND_BY_ID, accountId);
             
             if (result.empty())
             {
@@ -115,17 +198,7 @@ LoanAccount LoanAccountRepository::update(const LoanAccount& account)
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
         return db.executeQuery([&](pqxx::work& txn) -> LoanAccount {
-            std::string sql = R"(
-                UPDATE loan_accounts SET
-                    remaining_amount = $2,
-                    account_status = $3::account_status_enum,
-                    days_past_due = $4,
-                    number_of_missed_payments = $5
-                WHERE account_id = $1
-                RETURNING account_id
-            )";
-            
-            pqxx::result result = txn.exec_params(sql,
+            pqxx::result result = db.execPrepared(txn, UPDATE,
                 account.getAccountId(),
                 account.getRemainingAmount().getAmount(),
                 LoanAccount::statusToString(account.getStatus()),
@@ -159,8 +232,7 @@ bool LoanAccountRepository::deleteById(int accountId)
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
         return db.executeQuery([&](pqxx::work& txn) -> bool {
-            std::string sql = "DELETE FROM loan_accounts WHERE account_id = $1";
-            pqxx::result result = txn.exec_params(sql, accountId);
+            pqxx::result result = db.execPrepared(txn, DELETE_BY_ID, accountId);
             
             bool deleted = result.affected_rows() > 0;
             if (deleted)
@@ -189,18 +261,8 @@ std::vector<LoanAccount> LoanAccountRepository::findByBorrowerId(int borrowerId)
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
-        return db.executeQuery([&](pqxx::work& txn) -> std::vector<LoanAccount> {
-            std::string sql = R"(
-                SELECT account_id, borrower_id, loan_amount, initial_amount,
-                       interest_rate, remaining_amount, loan_start_date, loan_end_date,
-                       account_status, days_past_due, number_of_missed_payments,
-                       created_at, updated_at
-                FROM loan_accounts
-                WHERE borrower_id = $1
-                ORDER BY created_at DESC
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, borrowerId);
+        return db.executeRead([&](pqxx::nontransaction& txn) -> std::vector<LoanAccount> {
+            pqxx::result result = db.execPrepared(txn, FIND_BY_BORROWER_ID, borrowerId);
             
             std::vector<LoanAccount> accounts;
             accounts.reserve(result.size());
@@ -228,18 +290,8 @@ std::vector<LoanAccount> LoanAccountRepository::findByStatus(sdrs::constants::Ac
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
-        return db.executeQuery([&](pqxx::work& txn) -> std::vector<LoanAccount> {
-            std::string sql = R"(
-                SELECT account_id, borrower_id, loan_amount, initial_amount,
-                       interest_rate, remaining_amount, loan_start_date, loan_end_date,
-                       account_status, days_past_due, number_of_missed_payments,
-                       created_at, updated_at
-                FROM loan_accounts
-                WHERE account_status = $1::account_status_enum
-                ORDER BY days_past_due DESC
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, LoanAccount::statusToString(status));
+        return db.executeRead([&](pqxx::nontransaction& txn) -> std::vector<LoanAccount> {
+            pqxx::result result = db.execPrepared(txn, FIND_BY_STATUS, LoanAccount::statusToString(status));
             
             std::vector<LoanAccount> accounts;
             accounts.reserve(result.size());
@@ -267,19 +319,8 @@ std::vector<LoanAccount> LoanAccountRepository::findDelinquent(int minDaysPastDu
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
-        return db.executeQuery([&](pqxx::work& txn) -> std::vector<LoanAccount> {
-            std::string sql = R"(
-                SELECT account_id, borrower_id, loan_amount, initial_amount,
-                       interest_rate, remaining_amount, loan_start_date, loan_end_date,
-                       account_status, days_past_due, number_of_missed_payments,
-                       created_at, updated_at
-                FROM loan_accounts
-                WHERE days_past_due >= $1
-                  AND account_status NOT IN ('PaidOff', 'ChargedOff', 'Settled')
-                ORDER BY days_past_due DESC
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, minDaysPastDue);
+        return db.executeRead([&](pqxx::nontransaction& txn) -> std::vector<LoanAccount> {
+            pqxx::result result = db.execPrepared(txn, FIND_DELINQUENT, minDaysPastDue);
             
             std::vector<LoanAccount> accounts;
             accounts.reserve(result.size());
@@ -308,18 +349,8 @@ std::vector<LoanAccount> LoanAccountRepository::findAll()
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
-        return db.executeQuery([&](pqxx::work& txn) -> std::vector<LoanAccount> {
-            std::string sql = R"(
-                SELECT account_id, borrower_id, loan_amount, initial_amount,
-                       interest_rate, remaining_amount, loan_start_date, loan_end_date,
-                       account_status, days_past_due, number_of_missed_payments,
-                       created_at, updated_at
-                FROM loan_accounts
-                ORDER BY created_at DESC
-                LIMIT 100
-            )";
-            
-            pqxx::result result = txn.exec(sql);
+        return db.executeRead([&](pqxx::nontransaction& txn) -> std::vector<LoanAccount> {
+            pqxx::result result = db.execPrepared(txn, FIND_ALL);
             
             std::vector<LoanAccount> accounts;
             accounts.reserve(result.size());
@@ -347,8 +378,8 @@ int LoanAccountRepository::count()
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
-        return db.executeQuery([&](pqxx::work& txn) -> int {
-            pqxx::result result = txn.exec("SELECT COUNT(*) FROM loan_accounts");
+        return db.executeRead([&](pqxx::nontransaction& txn) -> int {
+            pqxx::result result = db.execPrepared(txn, COUNT);
             return result[0][0].as<int>();
         });
     }
@@ -372,13 +403,7 @@ bool LoanAccountRepository::updateStatus(int accountId, sdrs::constants::Account
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
         return db.executeQuery([&](pqxx::work& txn) -> bool {
-            std::string sql = R"(
-                UPDATE loan_accounts 
-                SET account_status = $2::account_status_enum
-                WHERE account_id = $1
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, accountId, LoanAccount::statusToString(status));
+            pqxx::result result = db.execPrepared(txn, UPDATE_STATUS, accountId, LoanAccount::statusToString(status));
             return result.affected_rows() > 0;
         });
     }
@@ -398,13 +423,7 @@ bool LoanAccountRepository::updateDaysPastDue(int accountId, int daysPastDue)
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
         return db.executeQuery([&](pqxx::work& txn) -> bool {
-            std::string sql = R"(
-                UPDATE loan_accounts 
-                SET days_past_due = $2
-                WHERE account_id = $1
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, accountId, daysPastDue);
+            pqxx::result result = db.execPrepared(txn, UPDATE_DAYS_PAST_DUE, accountId, daysPastDue);
             return result.affected_rows() > 0;
         });
     }
@@ -424,17 +443,7 @@ bool LoanAccountRepository::recordPayment(int accountId, double amount)
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
         return db.executeQuery([&](pqxx::work& txn) -> bool {
-            std::string sql = R"(
-                UPDATE loan_accounts 
-                SET remaining_amount = remaining_amount - $2,
-                    account_status = CASE 
-                        WHEN remaining_amount - $2 <= 0 THEN 'PaidOff'::account_status_enum
-                        ELSE account_status
-                    END
-                WHERE account_id = $1 AND remaining_amount >= $2
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, accountId, amount);
+            pqxx::result result = db.execPrepared(txn, RECORD_PAYMENT, accountId, amount);
             return result.affected_rows() > 0;
         });
     }
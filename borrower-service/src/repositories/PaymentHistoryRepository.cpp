@@ -8,6 +8,96 @@
 namespace sdrs::borrower
 {
 
+namespace
+{
+
+const sdrs::database::PreparedStatement CREATE("payment_history_create", R"(
+    INSERT INTO payment_history (
+        account_id, payment_amount, payment_method, payment_status,
+        payment_date, due_date, is_late, notes
+    ) VALUES ($1, $2, $3::payment_method_enum, $4::payment_status_enum, $5, $6, $7, $8)
+    RETURNING payment_id, created_at
+)");
+
+const sdrs::database::PreparedStatement FIND_BY_ID("payment_history_find_by_id", R"(
+    SELECT payment_id, account_id, payment_amount, payment_method, payment_status,
+           payment_date, due_date, is_late, notes, created_at, updated_at
+    FROM payment_history
+    WHERE payment_id = $1
+)");
+
+const sdrs::database::PreparedStatement UPDATE("payment_history_update", R"(
+    UPDATE payment_history SET
+        payment_status = $2::payment_status_enum,
+        notes = $3
+    WHERE payment_id = $1
+    RETURNING payment_id
+)");
+
+const sdrs::database::PreparedStatement DELETE_BY_ID("payment_history_delete_by_id", "DELETE FROM payment_history WHERE payment_id = $1");
+
+const sdrs::database::PreparedStatement FIND_BY_ACCOUNT_ID("payment_history_find_by_account_id", R"(
+    SELECT payment_id, account_id, payment_amount, payment_method, payment_status,
+           payment_date, due_date, is_late, notes, created_at, updated_at
+    FROM payment_history
+    WHERE account_id = $1
+    ORDER BY payment_date DESC
+)");
+
+const sdrs::database::PreparedStatement FIND_BY_STATUS("payment_history_find_by_status", R"(
+    SELECT payment_id, account_id, payment_amount, payment_method, payment_status,
+           payment_date, due_date, is_late, notes, created_at, updated_at
+    FROM payment_history
+    WHERE payment_status = $1::payment_status_enum
+    ORDER BY payment_date DESC
+)");
+
+const sdrs::database::PreparedStatement FIND_LATE_PAYMENTS("payment_history_find_late_payments", R"(
+    SELECT payment_id, account_id, payment_amount, payment_method, payment_status,
+           payment_date, due_date, is_late, notes, created_at, updated_at
+    FROM payment_history
+    WHERE is_late = true
+    ORDER BY payment_date DESC
+)");
+
+const sdrs::database::PreparedStatement FIND_BY_DATE_RANGE("payment_history_find_by_date_range", R"(
+    SELECT payment_id, account_id, payment_amount, payment_method, payment_status,
+           payment_date, due_date, is_late, notes, created_at, updated_at
+    FROM payment_history
+    WHERE payment_date >= $1::date AND payment_date <= $2::date
+    ORDER BY payment_date DESC
+)");
+
+const sdrs::database::PreparedStatement FIND_ALL("payment_history_find_all", R"(
+    SELECT payment_id, account_id, payment_amount, payment_method, payment_status,
+           payment_date, due_date, is_late, notes, created_at, updated_at
+    FROM payment_history
+    ORDER BY created_at DESC
+    LIMIT 100
+)");
+
+const sdrs::database::PreparedStatement COUNT("payment_history_count", "SELECT COUNT(*) FROM payment_history");
+
+const sdrs::database::PreparedStatement SUM_PAYMENTS_FOR_ACCOUNT("payment_history_sum_payments_for_account", R"(
+    SELECT COALESCE(SUM(payment_amount), 0) 
+    FROM payment_history 
+    WHERE account_id = $1 AND payment_status = 'Completed'
+)");
+
+const sdrs::database::PreparedStatement UPDATE_STATUS("payment_history_update_status", R"(
+    UPDATE payment_history 
+    SET payment_status = $2::payment_status_enum
+    WHERE payment_id = $1
+)");
+
+const sdrs::database::PreparedStatement MARK_AS_LATE("payment_history_mark_as_late", R"(
+    UPDATE payment_history 
+    SET is_late = $2
+    WHERE payment_id = $1
+)");
+
+}
+
 PaymentHistoryRepository::PaymentHistoryRepository(bool useMock)
     : _useMock(useMock)
 {
@@ -26,14 +116,6 @@ PaymentHistory PaymentHistoryRepository::create(const PaymentHistory& payment)
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
         return db.executeQuery([&](pqxx::work& txn) -> PaymentHistory {
-            std::string sql = R"(
-                INSERT INTO payment_history (
-                    account_id, payment_amount, payment_method, payment_status,
-                    payment_date, due_date, is_late, notes
-                ) VALUES ($1, $2, $3::payment_method_enum, $4::payment_status_enum, $5, $6, $7, $8)
-                RETURNING payment_id, created_at
-            )";
-            
             // Convert dates to strings
             auto paymentDate = payment.getPaymentDate();
             auto paymentDateStr = std::format("{:%Y-%m-%d}", paymentDate);
@@ -47,7 +129,7 @@ PaymentHistory PaymentHistoryRepository::create(const PaymentHistory& payment)
             pqxx::result result;
             if (dueDateStr.has_value())
             {
-                result = txn.exec_params(sql,
+                result = db.execPrepared(txn, CREATE,
                     payment.getAccountId(),
                     payment.getPaymentAmount().getAmount(),
                     PaymentHistory::paymentMethodToString(payment.getMethod()),
@@ -60,7 +142,7 @@ PaymentHistory PaymentHistoryRepository::create(const PaymentHistory& payment)
             }
             else
             {
-                result = txn.exec_params(sql,
+                result = db.execPrepared(txn, CREATE,
                     payment.getAccountId(),
                     payment.getPaymentAmount().getAmount(),
                     PaymentHistory::paymentMethodToString(payment.getMethod()),
@@ -103,15 +185,8 @@ std::optional<PaymentHistory> PaymentHistoryRepository::findById(int paymentId)
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
-        return db.executeQuery([&](pqxx::work& txn) -> std::optional<PaymentHistory> {
-            std::string sql = R"(
-                SELECT payment_id, account_id, payment_amount, payment_method, payment_status,
-                       payment_date, due_date, is_late, notes, created_at, updated_at
-                FROM payment_history
-                WHERE payment_id = $1
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, paymentId);
+        return db.executeRead([&](pqxx::nontransaction& txn) -> std::optional<PaymentHistory> {
+            pqxx::result result = db.execPrepared(txn, FIND_BY_ID, paymentId);
             
             if (result.empty())
             {
@@ -138,15 +213,7 @@ PaymentHistory PaymentHistoryRepository::update(const PaymentHistory& payment)
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
         return db.executeQuery([&](pqxx::work& txn) -> PaymentHistory {
-            std::string sql = R"(
-                UPDATE payment_history SET
-                    payment_status = $2::payment_status_enum,
-                    notes = $3
-                WHERE payment_id = $1
-                RETURNING payment_id
-            )";
-            
-            pqxx::result result = txn.exec_params(sql,
+            pqxx::result result = db.execPrepared(txn, UPDATE,
                 payment.getPaymentId(),
                 PaymentHistory::paymentStatusToString(payment.getStatus()),
                 payment.getNotes()
@@ -179,8 +246,7 @@ bool PaymentHistoryRepository::deleteById(int paymentId)
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
         return db.executeQuery([&](pqxx::work& txn) -> bool {
-            std::string sql = "DELETE FROM payment_history WHERE payment_id = $1";
-            pqxx::result result = txn.exec_params(sql, paymentId);
+            pqxx::result result = db.execPrepared(txn, DELETE_BY_ID, paymentId);
             
             bool deleted = result.affected_rows() > 0;
             if (deleted)
@@ -210,16 +276,8 @@ std::vector<PaymentHistory> PaymentHistoryRepository::findByAccountId(int accoun
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
-        return db.executeQuery([&](pqxx::work& txn) -> std::vector<PaymentHistory> {
-            std::string sql = R"(
-                SELECT payment_id, account_id, payment_amount, payment_method, payment_status,
-                       payment_date, due_date, is_late, notes, created_at, updated_at
-                FROM payment_history
-                WHERE account_id = $1
-                ORDER BY payment_date DESC
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, accountId);
+        return db.executeRead([&](pqxx::nontransaction& txn) -> std::vector<PaymentHistory> {
+            pqxx::result result = db.execPrepared(txn, FIND_BY_ACCOUNT_ID, accountId);
             
             std::vector<PaymentHistory> payments;
             payments.reserve(result.size());
@@ -240,6 +298,42 @@ std::vector<PaymentHistory> PaymentHistoryRepository::findByAccountId(int accoun
     return {}; // Unreachable
 }
 
+std::vector<PaymentHistory> PaymentHistoryRepository::findByAccountIds(std::span<const int> accountIds)
+{
+    if (_useMock) return findByAccountIdsMock(accountIds);
+    if (accountIds.empty()) return {};
+    
+    try
+    {
+        auto& db = sdrs::database::DatabaseManager::getInstance();
+        
+        // One FIND_BY_ACCOUNT_ID per account, so each keeps its index lookup and ordering
+        return db.executePipeline([&](sdrs::database::QueryPipeline& pipeline) -> std::vector<PaymentHistory> {
+            for (int accountId : accountIds)
+            {
+                pipeline.add(FIND_BY_ACCOUNT_ID, accountId);
+            }
+            
+            std::vector<PaymentHistory> payments;
+            for (size_t i = 0; i < pipeline.size(); ++i)
+            {
+                for (const auto& row : pipeline.result(i))
+                {
+                    payments.push_back(mapRowToPaymentHistory(row));
+                }
+            }
+            
+            return payments;
+        });
+    }
+    catch (const pqxx::sql_error& e)
+    {
+        sdrs::utils::Logger::Error("[DB] SQL error in findByAccountIds: " + std::string(e.what()));
+        throw sdrs::exceptions::DatabaseException(e.what(), sdrs::constants::DatabaseErrorCode::QueryFailed);
+    }
+    return {}; // Unreachable
+}
+
 std::vector<PaymentHistory> PaymentHistoryRepository::findByStatus(sdrs::constants::PaymentStatus status)
 {
     if (_useMock) return findAllMock();
@@ -248,15 +342,7 @@ std::vector<PaymentHistory> PaymentHistoryRepository::findByStatus(sdrs::constan
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
-        return db.executeQuery([&](pqxx::work& txn) -> std::vector<PaymentHistory> {
-            std::string sql = R"(
-                SELECT payment_id, account_id, payment_amount, payment_method, payment_status,
-                       payment_date, due_date, is_late, notes, created_at, updated_at
-                FROM payment_history
-                WHERE payment_status = $1::payment_status_enum
-                ORDER BY payment_date DESC
-            )";
-            
+        return db.executeRead([&](pqxx::nontransaction& txn) -> std::vector<PaymentHistory> {
             // Convert enum to string
             std::string statusStr;
             switch (status)
@@ -267,7 +353,7 @@ std::vector<PaymentHistory> PaymentHistoryRepository::findByStatus(sdrs::constan
                 case sdrs::constants::PaymentStatus::Cancelled: statusStr = "Cancelled"; break;
             }
             
-            pqxx::result result = txn.exec_params(sql, statusStr);
+            pqxx::result result = db.execPrepared(txn, FIND_BY_STATUS, statusStr);
             
             std::vector<PaymentHistory> payments;
             payments.reserve(result.size());
@@ -296,16 +382,8 @@ std::vector<PaymentHistory> PaymentHistoryRepository::findLatePayments()
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
-        return db.executeQuery([&](pqxx::work& txn) -> std::vector<PaymentHistory> {
-            std::string sql = R"(
-                SELECT payment_id, account_id, payment_amount, payment_method, payment_status,
-                       payment_date, due_date, is_late, notes, created_at, updated_at
-                FROM payment_history
-                WHERE is_late = true
-                ORDER BY payment_date DESC
-            )";
-            
-            pqxx::result result = txn.exec(sql);
+        return db.executeRead([&](pqxx::nontransaction& txn) -> std::vector<PaymentHistory> {
+            pqxx::result result = db.execPrepared(txn, FIND_LATE_PAYMENTS);
             
             std::vector<PaymentHistory> payments;
             payments.reserve(result.size());
@@ -335,16 +413,8 @@ std::vector<PaymentHistory> PaymentHistoryRepository::findByDateRange(const std:
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
-        return db.executeQuery([&](pqxx::work& txn) -> std::vector<PaymentHistory> {
-            std::string sql = R"(
-                SELECT payment_id, account_id, payment_amount, payment_method, payment_status,
-                       payment_date, due_date, is_late, notes, created_at, updated_at
-                FROM payment_history
-                WHERE payment_date >= $1::date AND payment_date <= $2::date
-                ORDER BY payment_date DESC
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, startDate, endDate);
+        return db.executeRead([&](pqxx::nontransaction& txn) -> std::vector<PaymentHistory> {
+            pqxx::result result = db.execPrepared(txn, FIND_BY_DATE_RANGE, startDate, endDate);
             
             std::vector<PaymentHistory> payments;
             payments.reserve(result.size());
@@ -378,16 +448,8 @@ std::vector<PaymentHistory> PaymentHistoryRepository::findAll()
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
-        return db.executeQuery([&](pqxx::work& txn) -> std::vector<PaymentHistory> {
-            std::string sql = R"(
-                SELECT payment_id, account_id, payment_amount, payment_method, payment_status,
-                       payment_date, due_date, is_late, notes, created_at, updated_at
-                FROM payment_history
-                ORDER BY created_at DESC
-                LIMIT 100
-            )";
-            
-            pqxx::result result = txn.exec(sql);
+        return db.executeRead([&](pqxx::nontransaction& txn) -> std::vector<PaymentHistory> {
+            pqxx::result result = db.execPrepared(txn, FIND_ALL);
             
             std::vector<PaymentHistory> payments;
             payments.reserve(result.size());
@@ -416,8 +478,8 @@ int PaymentHistoryRepository::count()
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
-        return db.executeQuery([&](pqxx::work& txn) -> int {
-            pqxx::result result = txn.exec("SELECT COUNT(*) FROM payment_history");
+        return db.executeRead([&](pqxx::nontransaction& txn) -> int {
+            pqxx::result result = db.execPrepared(txn, COUNT);
             return result[0][0].as<int>();
         });
     }
@@ -437,14 +499,8 @@ double PaymentHistoryRepository::sumPaymentsForAccount(int accountId)
     {
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
-        return db.executeQuery([&](pqxx::work& txn) -> double {
-            std::string sql = R"(
-                SELECT COALESCE(SUM(payment_amount), 0) 
-                FROM payment_history 
-                WHERE account_id = $1 AND payment_status = 'Completed'
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, accountId);
+        return db.executeRead([&](pqxx::nontransaction& txn) -> double {
+            pqxx::result result = db.execPrepared(txn, SUM_PAYMENTS_FOR_ACCOUNT, accountId);
             return result[0][0].as<double>();
         });
     }
@@ -469,12 +525,6 @@ bool PaymentHistoryRepository::updateStatus(int paymentId, sdrs::constants::Paym
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
         return db.executeQuery([&](pqxx::work& txn) -> bool {
-            std::string sql = R"(
-                UPDATE payment_history 
-                SET payment_status = $2::payment_status_enum
-                WHERE payment_id = $1
-            )";
-            
             std::string statusStr;
             switch (status)
             {
@@ -484,7 +534,7 @@ bool PaymentHistoryRepository::updateStatus(int paymentId, sdrs::constants::Paym
                 case sdrs::constants::PaymentStatus::Cancelled: statusStr = "Cancelled"; break;
             }
             
-            pqxx::result result = txn.exec_params(sql, paymentId, statusStr);
+            pqxx::result result = db.execPrepared(txn, UPDATE_STATUS, paymentId, statusStr);
             return result.affected_rows() > 0;
         });
     }
@@ -505,13 +555,7 @@ bool PaymentHistoryRepository::markAsLate(int paymentId, bool isLate)
         auto& db = sdrs::database::DatabaseManager::getInstance();
         
         return db.executeQuery([&](pqxx::work& txn) -> bool {
-            std::string sql = R"(
-                UPDATE payment_history 
-                SET is_late = $2
-                WHERE payment_id = $1
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, paymentId, isLate);
+            pqxx::result result = db.execPrepared(txn, MARK_AS_LATE, paymentId, isLate);
             return result.affected_rows() > 0;
         });
     }
@@ -621,6 +665,17 @@ std::vector<PaymentHistory> PaymentHistoryRepository::findByAccountIdMock(int ac
     return payments;
 }
 
+std::vector<PaymentHistory> PaymentHistoryRepository::findByAccountIdsMock(std::span<const int> accountIds)
+{
+    std::vector<PaymentHistory> payments;
+    for (int accountId : accountIds)
+    {
+        auto accountPayments = findByAccountIdMock(accountId);
+        payments.insert(payments.end(), accountPayments.begin(), accountPayments.end());
+    }
+    return payments;
+}
+
 std::vector<PaymentHistory> PaymentHistoryRepository::findAllMock()
 {
     sdrs::utils::Logger::Info("[MOCK] Finding all payments");
@@ -3,12 +3,20 @@
 #ifndef SDRS_COMMON_DATABASE_MANAGER_H
 #define SDRS_COMMON_DATABASE_MANAGER_H
 
+#include "../utils/Constants.h"
+#include "../utils/Logger.h"
+#include "../exceptions/DatabaseException.h"
 #include <pqxx/pqxx>
 #include <string>
+#include <vector>
 #include <format>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <utility>
+#include <algorithm>
 #include <condition_variable>
 #include <stdexcept>
 
@@ -23,8 +31,24 @@ struct DatabaseConfig
     std::string database = "sdrs";
     std::string user = "sdrs_user";
     std::string password = "sdrs_password";
-    int poolSize = 5;
+    int minPoolSize = sdrs::constants::database::MIN_POOL_SIZE;    // opened at startup and kept through quiet periods
+    int maxPoolSize = sdrs::constants::database::MAX_POOL_SIZE;    // further connections are opened on demand up to this
+    int acquireTimeoutMs = sdrs::constants::database::POOL_ACQUIRE_TIMEOUT_MS;
+    int idleTimeoutSeconds = sdrs::constants::database::POOL_IDLE_TIMEOUT_SEC;
+    int validationIntervalSeconds = sdrs::constants::database::POOL_VALIDATION_INTERVAL_SEC;  // 0 disables eviction and validation
     int connectionTimeout = 10;
+    std::string replicaHost;    // read replica for executeRead(); empty = reads go to the primary
+    int replicaPort = 5432;
+    
+    // Same database, credentials and pool sizing, pointed at the replica
+    DatabaseConfig replicaConfig() const
+    {
+        DatabaseConfig replica = *this;
+        replica.host = replicaHost;
+        replica.port = replicaPort;
+        replica.replicaHost.clear();
+        return replica;
+    }
     
     std::string getConnectionString() const
     {
@@ -40,28 +64,156 @@ struct DatabaseConfig
     }
 };
 
-// RAII wrapper for connection from pool
-class PooledConnection
+// A named statement, prepared on each pooled connection the first time it runs there.
+// Define instances at namespace scope next to the repository that runs them; the name must be
+// unique within the process.
+class PreparedStatement
 {
 private:
-    std::shared_ptr<pqxx::connection> _connection;
-    std::function<void(std::shared_ptr<pqxx::connection>)> _returnToPool;
+    static inline std::atomic<size_t> _nextId{0};
+    
+    size_t _id;  // index into each connection's prepared flags
+    std::string _name;
+    std::string _sql;
 
 public:
-    PooledConnection(std::shared_ptr<pqxx::connection> conn,
-                     std::function<void(std::shared_ptr<pqxx::connection>)> returnFunc)
-        : _connection(std::move(conn)), _returnToPool(std::move(returnFunc))
+    PreparedStatement(std::string name, std::string sql)
+        : _id(_nextId++), _name(std::move(name)), _sql(std::move(sql))
     {
         // Do nothing
     }
     
-    ~PooledConnection()
+    // Non-copyable: a copy would share the id
+    PreparedStatement(const PreparedStatement&) = delete;
+    PreparedStatement& operator=(const PreparedStatement&) = delete;
+    
+    size_t getId() const { return _id; }
+    const std::string& getName() const { return _name; }
+    const std::string& getSql() const { return _sql; }
+    
+    // Prepares on conn unless its flags say it already was
+    void prepareOn(pqxx::connection& conn, std::vector<bool>& prepared) const
+    {
+        if (_id >= prepared.size())
+        {
+            prepared.resize(_id + 1, false);
+        }
+        if (!prepared[_id])
+        {
+            conn.prepare(_name, _sql);
+            prepared[_id] = true;
+        }
+    }
+};
+
+// Statements queued by DatabaseManager::executePipeline(). Nothing reaches the server until the
+// first result() call, which sends the whole queue in one round trip. Arguments are quoted into
+// EXECUTE text because a pipeline carries plain query strings. Statements are prepared before
+// anything is sent; a prepare cannot run while pipelined queries are in flight.
+class QueryPipeline
+{
+private:
+    pqxx::nontransaction& _txn;
+    std::vector<bool>& _prepared;
+    std::vector<const PreparedStatement*> _statements;
+    std::vector<std::string> _queries;
+    std::vector<pqxx::result> _results;
+    bool _sent;
+
+public:
+    QueryPipeline(pqxx::nontransaction& txn, std::vector<bool>& prepared)
+        : _txn(txn), _prepared(prepared), _sent(false)
+    {
+        // Do nothing
+    }
+    
+    QueryPipeline(const QueryPipeline&) = delete;
+    QueryPipeline& operator=(const QueryPipeline&) = delete;
+    
+    // Queues statement; returns the index to read its rows back with
+    template<typename... Args>
+    size_t add(const PreparedStatement& statement, Args&&... args)
+    {
+        if (_sent)
+        {
+            throw std::logic_error("QueryPipeline: add() after the queue was sent");
+        }
+        
+        std::string query = "EXECUTE " + _txn.quote_name(statement.getName());
+        const char* separator = "(";
+        ((query += separator + _txn.quote(args), separator = ", "), ...);
+        if constexpr (sizeof...(Args) > 0)
+        {
+            query += ")";
+        }
+        
+        _statements.push_back(&statement);
+        _queries.push_back(std::move(query));
+        return _queries.size() - 1;
+    }
+    
+    const pqxx::result& result(size_t index)
+    {
+        if (!_sent)
+        {
+            send();
+        }
+        return _results.at(index);
+    }
+    
+    size_t size() const { return _queries.size(); }
+
+private:
+    void send()
     {
-        if (_connection && _returnToPool)
+        _sent = true;
+        if (_queries.empty())
+        {
+            return;
+        }
+        
+        for (const PreparedStatement* statement : _statements)
         {
-            _returnToPool(_connection);
+            statement->prepareOn(_txn.conn(), _prepared);
+        }
+        
+        pqxx::pipeline pipeline(_txn);
+        std::vector<pqxx::pipeline::query_id> ids;
+        ids.reserve(_queries.size());
+        for (const std::string& query : _queries)
+        {
+            ids.push_back(pipeline.insert(query));
+        }
+        pipeline.complete();
+        
+        _results.reserve(ids.size());
+        for (pqxx::pipeline::query_id id : ids)
+        {
+            _results.push_back(pipeline.retrieve(id));
         }
     }
+};
+
+class ConnectionPool;
+
+// RAII wrapper for connection from pool
+// Holds the pool and the slot it came from; no allocation per checkout
+class PooledConnection
+{
+private:
+    ConnectionPool* _pool;
+    size_t _slot;
+    pqxx::connection* _connection;
+    std::vector<bool>* _prepared;  // per PreparedStatement id, owned by the slot
+
+public:
+    PooledConnection(ConnectionPool* pool, size_t slot, pqxx::connection* conn, std::vector<bool>* prepared)
+        : _pool(pool), _slot(slot), _connection(conn), _prepared(prepared)
+    {
+        // Do nothing
+    }
+    
+    ~PooledConnection();
     
     // Non-copyable
     PooledConnection(const PooledConnection&) = delete;
@@ -69,67 +221,110 @@ public:
     
     // Movable
     PooledConnection(PooledConnection&& other) noexcept
-        : _connection(std::move(other._connection)),
-          _returnToPool(std::move(other._returnToPool))
+        : _pool(std::exchange(other._pool, nullptr)),
+          _slot(other._slot),
+          _connection(std::exchange(other._connection, nullptr)),
+          _prepared(std::exchange(other._prepared, nullptr))
     {
-        other._connection = nullptr;
+        // Do nothing
     }
     
-    PooledConnection& operator=(PooledConnection&& other) noexcept
-    {
-        if (this != &other)
-        {
-            if (_connection && _returnToPool)
-            {
-                _returnToPool(_connection);
-            }
-            _connection = std::move(other._connection);
-            _returnToPool = std::move(other._returnToPool);
-            other._connection = nullptr;
-        }
-        return *this;
-    }
+    PooledConnection& operator=(PooledConnection&& other) noexcept;
     
     pqxx::connection& get() { return *_connection; }
-    pqxx::connection* operator->() { return _connection.get(); }
+    pqxx::connection* operator->() { return _connection; }
+    std::vector<bool>& preparedStatements() { return *_prepared; }
 };
 
 // Connection pool for PostgreSQL
+// Connections live in maxPoolSize fixed slots whose state is claimed with a compare-and-swap, so
+// handing out and returning a connection takes no lock. Each thread starts its scan at the slot it
+// used last, which keeps busy threads off each other's cache lines and leaves rarely used slots
+// idle long enough to be evicted. Only a caller that finds every slot busy falls back to a mutex
+// and waits up to acquireTimeoutMs.
+// The pool keeps minPoolSize connections open and grows to maxPoolSize under load. A background
+// thread closes surplus connections idle for idleTimeoutSeconds and pings the remaining idle ones.
 class ConnectionPool
 {
 private:
-    std::queue<std::shared_ptr<pqxx::connection>> _pool;
-    std::mutex _mutex;
-    std::condition_variable _condition;
+    using Clock = std::chrono::steady_clock;
+    
+    enum class SlotState : uint8_t
+    {
+        Empty,       // no connection; may be claimed to open one
+        Idle,
+        InUse,       // checked out, or being opened by the caller that claimed it
+        Maintenance  // being pinged or closed by the maintenance thread
+    };
+    
+    // One cache line per slot. connection is only touched by whoever moved the slot out of Idle/Empty.
+    struct alignas(64) Slot
+    {
+        std::atomic<SlotState> state{SlotState::Empty};
+        std::unique_ptr<pqxx::connection> connection;
+        std::vector<bool> prepared;  // statements this connection has prepared; cleared with it
+        std::atomic<Clock::rep> idleSince{0};
+        std::atomic<Clock::rep> validatedAt{0};
+    };
+    
+    static constexpr size_t NO_SLOT = static_cast<size_t>(-1);
+    static inline thread_local size_t _slotHint = 0;
+    
     DatabaseConfig _config;
-    int _maxSize;
-    int _currentSize;
-    bool _stopped;
+    size_t _minSize;
+    size_t _maxSize;
+    std::unique_ptr<Slot[]> _slots;
+    std::atomic<size_t> _currentSize;  // slots that are not Empty
+    std::atomic<bool> _stopped;
+    
+    // Slow path only: callers waiting for a slot, and a counter bumped whenever one frees up
+    std::mutex _waitMutex;
+    std::condition_variable _condition;
+    std::atomic<int> _waiters;
+    uint64_t _releaseEpoch;
+    
+    std::mutex _maintenanceMutex;
+    std::condition_variable _maintenanceWakeup;
+    std::thread _maintenance;
 
 public:
     explicit ConnectionPool(const DatabaseConfig& config)
-        : _config(config), _maxSize(config.poolSize), _currentSize(0), _stopped(false)
+        : _config(config),
+          _minSize(static_cast<size_t>(std::clamp(config.minPoolSize, 0, std::max(config.maxPoolSize, 1)))),
+          _maxSize(static_cast<size_t>(std::max(config.maxPoolSize, 1))),
+          _slots(std::make_unique<Slot[]>(_maxSize)),
+          _currentSize(0),
+          _stopped(false),
+          _waiters(0),
+          _releaseEpoch(0)
     {
-        // Pre-create connections
-        for (int i = 0; i < _maxSize; ++i)
+        // Pre-create the minimum; at least one, so an unreachable database fails at startup
+        size_t initialSize = std::max<size_t>(_minSize, 1);
+        for (size_t i = 0; i < initialSize; ++i)
         {
             try
             {
-                auto conn = std::make_shared<pqxx::connection>(_config.getConnectionString());
-                _pool.push(conn);
+                _slots[i].connection = std::make_unique<pqxx::connection>(_config.getConnectionString());
+                markIdle(_slots[i], Clock::now());
                 ++_currentSize;
             }
             catch (const std::exception& e)
             {
                 // If first connection fails, throw error
                 if (i == 0) {
-                    throw std::runtime_error("Failed to create initial database connection: " + std::string(e.what()) + 
+                    throw sdrs::exceptions::DatabaseException("Failed to create initial database connection: " + std::string(e.what()) + 
                         "\nConnection string: host=" + _config.host + " port=" + std::to_string(_config.port) + 
-                        " dbname=" + _config.database + " user=" + _config.user);
+                        " dbname=" + _config.database + " user=" + _config.user,
+                        sdrs::constants::DatabaseErrorCode::ConnectionFailed);
                 }
                 break;
             }
         }
+        
+        if (_config.validationIntervalSeconds > 0)
+        {
+            _maintenance = std::thread(&ConnectionPool::maintain, this);
+        }
     }
     
     ~ConnectionPool()
@@ -137,79 +332,379 @@ public:
         shutdown();
     }
     
+    // Non-copyable
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+    
     PooledConnection acquire()
     {
-        std::unique_lock<std::mutex> lock(_mutex);
-        
-        // Wait for available connection
-        _condition.wait(lock, [this] {
-            return !_pool.empty() || _stopped;
-        });
-        
         if (_stopped)
         {
-            throw std::runtime_error("Connection pool is stopped");
+            throw sdrs::exceptions::DatabaseException("Connection pool is stopped",
+                sdrs::constants::DatabaseErrorCode::ConnectionFailed);
         }
         
-        auto conn = _pool.front();
-        _pool.pop();
+        size_t slot = tryAcquire();
+        if (slot != NO_SLOT)
+        {
+            return checkout(slot);
+        }
+        return acquireSlow();
+    }
+    
+    void release(size_t slot)
+    {
+        Slot& entry = _slots[slot];
+        if ((_stopped)
+            || (!entry.connection->is_open()))
+        {
+            close(entry);
+            return;
+        }
+        markIdle(entry, Clock::now());
+        notifyWaiters();
+    }
+    
+    void shutdown()
+    {
+        _stopped = true;
+        {
+            std::lock_guard<std::mutex> lock(_waitMutex);
+            ++_releaseEpoch;
+        }
+        _condition.notify_all();
+        {
+            // Pairs with the predicate check in maintain(), so the wakeup cannot be missed
+            std::lock_guard<std::mutex> lock(_maintenanceMutex);
+        }
+        _maintenanceWakeup.notify_all();
         
-        // Check if connection is still valid
-        if (!conn->is_open())
+        if (_maintenance.joinable())
         {
-            try
+            _maintenance.join();
+        }
+        
+        // Checked-out connections are closed as they come back
+        for (size_t i = 0; i < _maxSize; ++i)
+        {
+            if (claim(_slots[i], SlotState::Idle, SlotState::Maintenance))
             {
-                conn = std::make_shared<pqxx::connection>(_config.getConnectionString());
+                close(_slots[i]);
             }
-            catch (const std::exception& e)
+        }
+    }
+    
+    size_t availableConnections() const
+    {
+        size_t idle = 0;
+        for (size_t i = 0; i < _maxSize; ++i)
+        {
+            idle += _slots[i].state.load(std::memory_order_relaxed) == SlotState::Idle;
+        }
+        return idle;
+    }
+    
+    size_t totalConnections() const
+    {
+        return _currentSize.load();
+    }
+    
+    bool isHealthy() const
+    {
+        return (!_stopped)
+            && ((_currentSize > 0) || (_minSize == 0));
+    }
+
+private:
+    static bool claim(Slot& slot, SlotState from, SlotState to)
+    {
+        // Cheap load first so a busy slot costs no cache-line write
+        return (slot.state.load(std::memory_order_relaxed) == from)
+            && (slot.state.compare_exchange_strong(from, to, std::memory_order_acquire));
+    }
+    
+    static void markIdle(Slot& slot, Clock::time_point now)
+    {
+        slot.idleSince.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+        slot.validatedAt.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+        slot.state.store(SlotState::Idle);
+    }
+    
+    PooledConnection checkout(size_t slot)
+    {
+        return PooledConnection(this, slot, _slots[slot].connection.get(), &_slots[slot].prepared);
+    }
+    
+    void close(Slot& slot)
+    {
+        slot.connection.reset();
+        slot.prepared.clear();
+        slot.state.store(SlotState::Empty);
+        --_currentSize;
+        notifyWaiters();
+    }
+    
+    // Lock-free: reuse an idle connection, else open one in an empty slot; NO_SLOT when all are busy
+    size_t tryAcquire()
+    {
+        size_t start = _slotHint % _maxSize;
+        for (size_t i = 0; i < _maxSize; ++i)
+        {
+            size_t index = (start + i) % _maxSize;
+            if (claim(_slots[index], SlotState::Idle, SlotState::InUse))
             {
-                // Return invalid connection to trigger retry
-                throw std::runtime_error("Failed to reconnect: " + std::string(e.what()));
+                // Check if connection is still valid
+                if (!_slots[index].connection->is_open())
+                {
+                    openInto(index);
+                }
+                _slotHint = index;
+                return index;
             }
         }
         
-        return PooledConnection(conn, [this](std::shared_ptr<pqxx::connection> c) {
-            release(c);
-        });
+        for (size_t i = 0; i < _maxSize; ++i)
+        {
+            size_t index = (start + i) % _maxSize;
+            if (claim(_slots[index], SlotState::Empty, SlotState::InUse))
+            {
+                ++_currentSize;
+                openInto(index);
+                _slotHint = index;
+                return index;
+            }
+        }
+        return NO_SLOT;
     }
     
-    void release(std::shared_ptr<pqxx::connection> conn)
+    // The slot is claimed and counted; connect without holding anything else up
+    void openInto(size_t index)
     {
-        std::lock_guard<std::mutex> lock(_mutex);
-        if (!_stopped)
+        Slot& slot = _slots[index];
+        slot.prepared.clear();
+        try
+        {
+            slot.connection = std::make_unique<pqxx::connection>(_config.getConnectionString());
+        }
+        catch (const std::exception& e)
         {
-            _pool.push(conn);
-            _condition.notify_one();
+            close(slot);
+            throw sdrs::exceptions::DatabaseException("Failed to open database connection: " + std::string(e.what()),
+                sdrs::constants::DatabaseErrorCode::ConnectionFailed);
         }
     }
     
-    void shutdown()
+    PooledConnection acquireSlow()
     {
-        std::lock_guard<std::mutex> lock(_mutex);
-        _stopped = true;
-        while (!_pool.empty())
+        auto deadline = Clock::now() + std::chrono::milliseconds(_config.acquireTimeoutMs);
+        
+        // Registered before scanning: a slot freed after our scan is then guaranteed to bump the epoch
+        ++_waiters;
+        struct WaiterGuard
+        {
+            std::atomic<int>& waiters;
+            ~WaiterGuard() { --waiters; }
+        } guard{_waiters};
+        
+        // claim() pre-loads slot states relaxed. Without a full fence a weakly ordered CPU may let that
+        // load see a stale InUse while the releaser's _waiters.load() still sees 0, and neither side acts.
+        // Later scans are ordered by _waitMutex, which the releaser takes after its Idle store.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        
+        while (true)
         {
-            _pool.pop();
+            uint64_t epoch;
+            {
+                std::lock_guard<std::mutex> lock(_waitMutex);
+                epoch = _releaseEpoch;
+            }
+            
+            size_t slot = tryAcquire();
+            if (slot != NO_SLOT)
+            {
+                return checkout(slot);
+            }
+            
+            std::unique_lock<std::mutex> lock(_waitMutex);
+            bool woken = _condition.wait_until(lock, deadline, [this, epoch] {
+                return _stopped || _releaseEpoch != epoch;
+            });
+            
+            if (_stopped)
+            {
+                throw sdrs::exceptions::DatabaseException("Connection pool is stopped",
+                    sdrs::constants::DatabaseErrorCode::ConnectionFailed);
+            }
+            if (!woken)
+            {
+                throw sdrs::exceptions::DatabaseException(
+                    "Timed out after " + std::to_string(_config.acquireTimeoutMs) + " ms waiting for a database connection ("
+                        + std::to_string(_maxSize) + " in use)",
+                    sdrs::constants::DatabaseErrorCode::PoolExhausted);
+            }
         }
-        _condition.notify_all();
     }
     
-    size_t availableConnections() const
+    void notifyWaiters()
+    {
+        if (_waiters.load() == 0)
+        {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(_waitMutex);
+            ++_releaseEpoch;
+        }
+        _condition.notify_one();
+    }
+    
+    static bool ping(pqxx::connection& conn)
     {
-        return _pool.size();
+        try
+        {
+            pqxx::nontransaction txn(conn);
+            txn.exec("SELECT 1");
+            return true;
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
     }
     
-    bool isHealthy() const
+    // Background thread: every validationIntervalSeconds evict, validate, then top up to the minimum
+    void maintain()
     {
-        return !_stopped && _currentSize > 0;
+        auto interval = std::chrono::seconds(_config.validationIntervalSeconds);
+        std::unique_lock<std::mutex> lock(_maintenanceMutex);
+        while (!_maintenanceWakeup.wait_for(lock, interval, [this] { return _stopped.load(); }))
+        {
+            lock.unlock();
+            maintainSlots(interval);
+            fillToMinimum();
+            lock.lock();
+        }
+    }
+    
+    void maintainSlots(std::chrono::seconds interval)
+    {
+        auto now = Clock::now();
+        auto evictBefore = (now - std::chrono::seconds(_config.idleTimeoutSeconds)).time_since_epoch().count();
+        auto validateBefore = (now - interval).time_since_epoch().count();
+        
+        for (size_t i = 0; (i < _maxSize) && (!_stopped); ++i)
+        {
+            Slot& slot = _slots[i];
+            if (!claim(slot, SlotState::Idle, SlotState::Maintenance))
+            {
+                continue;
+            }
+            
+            if ((_currentSize > _minSize)
+                && (slot.idleSince.load(std::memory_order_relaxed) < evictBefore))
+            {
+                close(slot);
+            }
+            else if ((slot.validatedAt.load(std::memory_order_relaxed) <= validateBefore)
+                && (!ping(*slot.connection)))
+            {
+                close(slot);
+            }
+            else
+            {
+                // Keeps its idle age; only the validation time moves
+                slot.validatedAt.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+                slot.state.store(SlotState::Idle);
+                notifyWaiters();
+            }
+        }
+    }
+    
+    void fillToMinimum()
+    {
+        for (size_t i = 0; (i < _maxSize) && (!_stopped) && (_currentSize < _minSize); ++i)
+        {
+            if (!claim(_slots[i], SlotState::Empty, SlotState::Maintenance))
+            {
+                continue;
+            }
+            
+            ++_currentSize;
+            try
+            {
+                _slots[i].connection = std::make_unique<pqxx::connection>(_config.getConnectionString());
+            }
+            catch (const std::exception&)
+            {
+                // Retried on the next round
+                close(_slots[i]);
+                return;
+            }
+            markIdle(_slots[i], Clock::now());
+            notifyWaiters();
+        }
     }
 };
 
+inline PooledConnection::~PooledConnection()
+{
+    if (_pool)
+    {
+        _pool->release(_slot);
+    }
+}
+
+inline PooledConnection& PooledConnection::operator=(PooledConnection&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (_pool)
+        {
+            _pool->release(_slot);
+        }
+        _pool = std::exchange(other._pool, nullptr);
+        _slot = other._slot;
+        _connection = std::exchange(other._connection, nullptr);
+        _prepared = std::exchange(other._prepared, nullptr);
+    }
+    return *this;
+}
+
 // Singleton Database Manager
 class DatabaseManager
 {
 private:
+    // The checkout the calling thread's executeQuery()/executeCommand() is running on, so
+    // execPrepared() can find the connection's prepared flags from the transaction alone
+    class SessionScope
+    {
+    private:
+        pqxx::connection* _connection;
+        std::vector<bool>* _prepared;
+        SessionScope* _previous;  // nested executeQuery() calls restore the outer checkout
+
+    public:
+        explicit SessionScope(PooledConnection& conn)
+            : _connection(&conn.get()), _prepared(&conn.preparedStatements()), _previous(_activeSession)
+        {
+            _activeSession = this;
+        }
+        
+        ~SessionScope()
+        {
+            _activeSession = _previous;
+        }
+        
+        SessionScope(const SessionScope&) = delete;
+        SessionScope& operator=(const SessionScope&) = delete;
+        
+        friend class DatabaseManager;
+    };
+    
+    static inline thread_local SessionScope* _activeSession = nullptr;
+    
     std::unique_ptr<ConnectionPool> _pool;
+    std::unique_ptr<ConnectionPool> _replicaPool;  // null without a replica
     DatabaseConfig _config;
     bool _initialized;
     
@@ -237,6 +732,19 @@ public:
         
         _config = config;
         _pool = std::make_unique<ConnectionPool>(_config);
+        
+        if (!_config.replicaHost.empty())
+        {
+            try
+            {
+                _replicaPool = std::make_unique<ConnectionPool>(_config.replicaConfig());
+            }
+            catch (const std::exception& e)
+            {
+                // The primary can serve reads too; a missing replica must not stop the service
+                sdrs::utils::Logger::Warn("[DB] Read replica unavailable, reading from the primary: " + std::string(e.what()));
+            }
+        }
         _initialized = true;
     }
     
@@ -256,7 +764,22 @@ public:
         if (const char* pass = std::getenv("SDRS_DB_PASSWORD"))
             config.password = pass;
         if (const char* poolSize = std::getenv("SDRS_DB_POOL_SIZE"))
-            config.poolSize = std::stoi(poolSize);
+            config.maxPoolSize = std::stoi(poolSize);
+        if (const char* minSize = std::getenv("SDRS_DB_POOL_MIN"))
+            config.minPoolSize = std::stoi(minSize);
+        if (const char* maxSize = std::getenv("SDRS_DB_POOL_MAX"))
+            config.maxPoolSize = std::stoi(maxSize);
+        if (const char* timeout = std::getenv("SDRS_DB_ACQUIRE_TIMEOUT_MS"))
+            config.acquireTimeoutMs = std::stoi(timeout);
+        if (const char* idle = std::getenv("SDRS_DB_POOL_IDLE_TIMEOUT"))
+            config.idleTimeoutSeconds = std::stoi(idle);
+        if (const char* interval = std::getenv("SDRS_DB_POOL_VALIDATION_INTERVAL"))
+            config.validationIntervalSeconds = std::stoi(interval);
+        if (const char* replicaHost = std::getenv("SDRS_DB_REPLICA_HOST"))
+            config.replicaHost = replicaHost;
+        config.replicaPort = config.port;
+        if (const char* replicaPort = std::getenv("SDRS_DB_REPLICA_PORT"))
+            config.replicaPort = std::stoi(replicaPort);
             
         initialize(config);
     }
@@ -271,11 +794,37 @@ public:
         return _pool->acquire();
     }
     
+    // Connection for reads: the replica when there is one, the primary when it cannot connect
+    PooledConnection getReadConnection()
+    {
+        if (!_initialized)
+        {
+            throw std::runtime_error("DatabaseManager not initialized. Call initialize() first.");
+        }
+        if (_replicaPool)
+        {
+            try
+            {
+                return _replicaPool->acquire();
+            }
+            catch (const sdrs::exceptions::DatabaseException& e)
+            {
+                // A busy replica is not retried on the primary, or read spikes would land there
+                if (e.getErrorCode() != sdrs::constants::DatabaseErrorCode::ConnectionFailed)
+                {
+                    throw;
+                }
+            }
+        }
+        return _pool->acquire();
+    }
+    
     // Execute query with result
     template<typename Func>
     auto executeQuery(Func&& func) -> decltype(func(std::declval<pqxx::work&>()))
     {
         auto conn = getConnection();
+        SessionScope session(conn);
         pqxx::work txn(conn.get());
         
         try
@@ -291,11 +840,36 @@ public:
         }
     }
     
+    // Execute a read without a transaction block: each statement commits on its own, which saves
+    // the BEGIN and COMMIT round trips. Meant for reads of a single statement; runs on the replica
+    // when one is configured, so a read issued right after a write may not see it yet.
+    template<typename Func>
+    auto executeRead(Func&& func) -> decltype(func(std::declval<pqxx::nontransaction&>()))
+    {
+        auto conn = getReadConnection();
+        SessionScope session(conn);
+        pqxx::nontransaction txn(conn.get());
+        return func(txn);
+    }
+    
+    // Execute several reads in one round trip: func queues statements on the pipeline and reads
+    // the results back, all on one connection. Same replica caveat as executeRead().
+    template<typename Func>
+    auto executePipeline(Func&& func) -> decltype(func(std::declval<QueryPipeline&>()))
+    {
+        auto conn = getReadConnection();
+        SessionScope session(conn);
+        pqxx::nontransaction txn(conn.get());
+        QueryPipeline pipeline(txn, conn.preparedStatements());
+        return func(pipeline);
+    }
+    
     // Execute query without result (INSERT, UPDATE, DELETE)
     template<typename Func>
     void executeCommand(Func&& func)
     {
         auto conn = getConnection();
+        SessionScope session(conn);
         pqxx::work txn(conn.get());
         
         try
@@ -310,11 +884,29 @@ public:
         }
     }
     
+    // Runs statement by name, preparing it first if this connection has not seen it yet.
+    // Outside executeQuery()/executeCommand() the connection's state is unknown, so the SQL text
+    // is sent instead.
+    template<typename... Args>
+    pqxx::result execPrepared(pqxx::transaction_base& txn, const PreparedStatement& statement, Args&&... args)
+    {
+        SessionScope* session = _activeSession;
+        if ((session == nullptr)
+            || (session->_connection != &txn.conn()))
+        {
+            return txn.exec_params(statement.getSql(), std::forward<Args>(args)...);
+        }
+        
+        statement.prepareOn(txn.conn(), *session->_prepared);
+        return txn.exec_prepared(statement.getName(), std::forward<Args>(args)...);
+    }
+    
     // Health check
     bool isHealthy() const
     {
         return _initialized && _pool && _pool->isHealthy();
     }
+
     
     // Shutdown
     void shutdown()
@@ -323,6 +915,10 @@ public:
         {
             _pool->shutdown();
         }
+        if (_replicaPool)
+        {
+            _replicaPool->shutdown();
+        }
         _initialized = false;
     }
     
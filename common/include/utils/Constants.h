@@ -31,6 +31,9 @@ namespace database
     inline constexpr int CONNECTION_TIMEOUT_SEC = 30;
     inline constexpr int MAX_POOL_SIZE = 10;
     inline constexpr int MIN_POOL_SIZE = 2;
+    inline constexpr int POOL_ACQUIRE_TIMEOUT_MS = 5000;    // wait for a free connection before failing
+    inline constexpr int POOL_IDLE_TIMEOUT_SEC = 300;       // idle connections above the minimum are closed after this
+    inline constexpr int POOL_VALIDATION_INTERVAL_SEC = 30; // idle connections are pinged this often
 }
 
 // ============================================================================
@@ -127,6 +130,7 @@ enum class DatabaseErrorCode
     ConstraintViolation,   // Generic database constraint violated
     UniqueViolation,       // UNIQUE constraint violated (e.g., duplicate email)
     ForeignKeyViolation,   // Foreign key constraint violated
+    PoolExhausted,         // No pooled connection became free within the acquire timeout
     Unknown                // Unclassified database error
 };
 
@@ -179,6 +183,7 @@ namespace risk
     // Risk score boundaries (0.0 to 1.0)
     inline constexpr double LOW_RISK_MAX = 0.33;
     inline constexpr double MEDIUM_RISK_MAX = 0.67;
+    inline constexpr double RISK_SCORE_SCALE = 1000.0;  // risk_assessments.risk_score is DECIMAL(5,3)
 
     // Days past due thresholds
     inline constexpr int DPD_LOW_THRESHOLD = 30;      // 1-30 days: Low risk
@@ -192,11 +197,42 @@ namespace risk
     inline constexpr int RF_MIN_SAMPLES_SPLIT = 10;  // Increased from 5
     inline constexpr int RF_LEAF_FEATURES_INDEX = -1;
     inline constexpr double RF_VARIANCE_EPSILON = 1e-7;
+    inline constexpr size_t RF_BATCH_BLOCK_SIZE = 256;  // rows walked together per tree in batch prediction
+    inline constexpr int RF_HISTOGRAM_MAX_BINS = 256;   // histogram training: bins per feature (fits uint8)
+    inline constexpr int RF_PERMUTATION_REPEATS = 5;    // shuffles per feature for permutation importance
 
     // K-Means hyperparameters
     inline constexpr int KMEANS_NUM_CLUSTERS = 3;
     inline constexpr int KMEANS_MAX_ITERATIONS = 100;
     inline constexpr double KMEANS_TOLERANCE = 1e-4;
+    inline constexpr int KMEANS_STREAM_PAGE_SIZE = 5000;   // accounts per mini-batch / DB page when streaming
+    inline constexpr int KMEANS_MINI_BATCH_PASSES = 3;     // partialFit scans over the portfolio
+    inline constexpr size_t KMEANS_MIN_POINTS_PER_THREAD = 4096;  // below this a worker costs more than it saves
+    inline constexpr int KMEANS_AUTO_MIN_K = 2;            // auto-k search range, inclusive
+    inline constexpr int KMEANS_AUTO_MAX_K = 8;
+    inline constexpr int KMEANS_AUTO_RESTARTS = 3;         // seeded restarts per k; the lowest inertia wins
+    inline constexpr int KMEANS_AUTO_K_LIMIT = 16;         // caps caller-supplied max_k
+    inline constexpr int KMEANS_AUTO_RESTARTS_LIMIT = 10;  // caps caller-supplied restarts
+    inline constexpr size_t KMEANS_SILHOUETTE_SAMPLES = 2000;  // silhouette is O(n^2), so it runs on a sample
+
+    // Binary model artifacts
+    inline constexpr const char* MODEL_FILE_MAGIC = "SDRSMDL";  // 7 chars + NUL fill the 8-byte header field
+    inline constexpr uint32_t MODEL_FORMAT_VERSION = 2;         // bump on any layout change (2: seed + feature importances)
+    inline constexpr const char* DEFAULT_RISK_MODEL_PATH = "models/risk_forest.sdrsm";
+    inline constexpr int MODEL_WATCH_INTERVAL_SECONDS = 30;     // artifact poll period; 0 disables the watcher
+
+    // Assessment result cache
+    inline constexpr size_t RISK_CACHE_CAPACITY = 100000;  // entries across all shards; 0 disables the cache
+    inline constexpr int RISK_CACHE_TTL_SECONDS = 300;
+    inline constexpr size_t RISK_CACHE_SHARDS = 16;
+
+    // Incremental re-scoring
+    inline constexpr int RESCORE_INTERVAL_SECONDS = 60;   // change-feed poll period; 0 disables the background pass
+    inline constexpr int RESCORE_LOOKBACK_SECONDS = 60;   // overlap re-read for writes that commit after the watermark
+    inline constexpr int RESCORE_PAGE_SIZE = 5000;        // accounts per DB page and scoring batch
+
+    // POST /assess-risk/batch: the request is parsed and scored whole before streaming, so it is capped
+    inline constexpr size_t RISK_BATCH_MAX_ROWS = 50000;
 }
 
 // ============================================================================
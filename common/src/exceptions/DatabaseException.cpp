@@ -44,6 +44,9 @@ std::string DatabaseException::getDetail() const
     case DatabaseErrorCode::UniqueViolation:
         detail += "UniqueViolation";
         break;
+    case DatabaseErrorCode::PoolExhausted:
+        detail += "PoolExhausted";
+        break;
     default:
         detail += "Unknown";
         break;
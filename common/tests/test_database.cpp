@@ -0,0 +1,279 @@
+#include "../include/database/DatabaseManager.h"
+#include "../include/exceptions/DatabaseException.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sdrs::database;
+using namespace sdrs::exceptions;
+using sdrs::constants::DatabaseErrorCode;
+
+// ctest treats this exit code as "skipped" (SKIP_RETURN_CODE)
+constexpr int EXIT_SKIPPED = 77;
+
+int failures = 0;
+
+void printResult(const std::string& testName, bool passed)
+{
+    std::cout << "[TEST] " << testName << " : " << (passed ? "PASSED" : "FAILED") << std::endl;
+    failures += passed ? 0 : 1;
+}
+
+void runTest(const std::string& testName, const std::function<bool()>& test)
+{
+    try
+    {
+        printResult(testName, test());
+    }
+    catch (const std::exception& ex)
+    {
+        printResult(testName, false);
+        std::cout << "  -> " << ex.what() << std::endl;
+    }
+}
+
+// Connection settings from the same SDRS_DB_* variables as DatabaseManager::initializeFromEnv();
+// pool sizing is chosen per test
+DatabaseConfig poolConfig(int minSize, int maxSize, int acquireTimeoutMs)
+{
+    DatabaseConfig config;
+    if (const char* host = std::getenv("SDRS_DB_HOST"))
+        config.host = host;
+    if (const char* port = std::getenv("SDRS_DB_PORT"))
+        config.port = std::stoi(port);
+    if (const char* db = std::getenv("SDRS_DB_NAME"))
+        config.database = db;
+    if (const char* user = std::getenv("SDRS_DB_USER"))
+        config.user = user;
+    if (const char* pass = std::getenv("SDRS_DB_PASSWORD"))
+        config.password = pass;
+
+    config.minPoolSize = minSize;
+    config.maxPoolSize = maxSize;
+    config.acquireTimeoutMs = acquireTimeoutMs;
+    config.validationIntervalSeconds = 0;  // no maintenance thread unless a test asks for one
+    config.connectionTimeout = 3;
+    return config;
+}
+
+long long millisSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool throwsPoolError(ConnectionPool& pool, DatabaseErrorCode expected)
+{
+    try
+    {
+        auto conn = pool.acquire();
+        return false;
+    }
+    catch (const DatabaseException& ex)
+    {
+        return ex.getErrorCode() == expected;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// ConnectionPool
+// ---------------------------------------------------------------------------
+
+bool testAcquireTimesOut()
+{
+    ConnectionPool pool(poolConfig(1, 1, 200));
+    auto held = pool.acquire();
+
+    auto start = std::chrono::steady_clock::now();
+    bool exhausted = throwsPoolError(pool, DatabaseErrorCode::PoolExhausted);
+    long long waited = millisSince(start);
+    return exhausted
+        && (waited >= 150)
+        && (waited < 2000);
+}
+
+bool testWaiterGetsReleasedConnection()
+{
+    ConnectionPool pool(poolConfig(1, 1, 5000));
+    std::thread holder([held = pool.acquire()]() mutable {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        PooledConnection released = std::move(held);  // hands the slot back on return
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    bool acquired = false;
+    try
+    {
+        auto conn = pool.acquire();
+        acquired = conn->is_open();
+    }
+    catch (const DatabaseException&)
+    {
+        // Reported below; the holder thread still has to be joined
+    }
+    long long waited = millisSince(start);
+    holder.join();
+    return acquired
+        && (waited < 2000);
+}
+
+bool testPoolGrowsToMaximum()
+{
+    ConnectionPool pool(poolConfig(1, 3, 100));
+    size_t initial = pool.totalConnections();
+
+    auto first = pool.acquire();
+    auto second = pool.acquire();
+    auto third = pool.acquire();
+    return (initial == 1)
+        && (pool.totalConnections() == 3)
+        && (pool.availableConnections() == 0)
+        && (throwsPoolError(pool, DatabaseErrorCode::PoolExhausted));
+}
+
+bool testIdleConnectionsShrinkToMinimum()
+{
+    DatabaseConfig config = poolConfig(1, 3, 1000);
+    config.idleTimeoutSeconds = 1;
+    config.validationIntervalSeconds = 1;
+    ConnectionPool pool(config);
+    {
+        auto first = pool.acquire();
+        auto second = pool.acquire();
+        auto third = pool.acquire();
+    }
+    size_t afterBurst = pool.totalConnections();
+
+    auto start = std::chrono::steady_clock::now();
+    while ((pool.totalConnections() > 1)
+        && (millisSince(start) < 6000))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    return (afterBurst == 3)
+        && (pool.totalConnections() == 1)
+        && (pool.availableConnections() == 1);
+}
+
+bool testStoppedPoolRejectsCheckout()
+{
+    ConnectionPool pool(poolConfig(1, 2, 100));
+    pool.shutdown();
+    return (throwsPoolError(pool, DatabaseErrorCode::ConnectionFailed))
+        && (!pool.isHealthy());
+}
+
+// ---------------------------------------------------------------------------
+// QueryPipeline: one round trip must return what one-at-a-time execution returns
+// ---------------------------------------------------------------------------
+
+const PreparedStatement ADD_ONE{"test_pipeline_add_one", "SELECT $1::int + 1"};
+const PreparedStatement SERIES{"test_pipeline_series", "SELECT generate_series(1, $1::int)"};
+const PreparedStatement ECHO_TEXT{"test_pipeline_echo", "SELECT $1::text"};
+
+const std::vector<int> NUMBERS = {0, 1, -5, 41, 2147483646};
+const std::vector<int> SERIES_LENGTHS = {0, 1, 3};
+const std::vector<std::string> TEXTS = {"", "O'Brien", "a'); DROP TABLE borrowers; --", "Nguyễn Văn A", "\\N"};
+
+using Rows = std::vector<std::vector<std::string>>;
+
+Rows toRows(const pqxx::result& result)
+{
+    Rows rows;
+    for (const auto& row : result)
+    {
+        rows.push_back({row[0].c_str()});
+    }
+    return rows;
+}
+
+std::vector<Rows> runOneAtATime()
+{
+    auto& db = DatabaseManager::getInstance();
+    return db.executeRead([&db](pqxx::nontransaction& txn) {
+        std::vector<Rows> results;
+        for (int number : NUMBERS) results.push_back(toRows(db.execPrepared(txn, ADD_ONE, number)));
+        for (int length : SERIES_LENGTHS) results.push_back(toRows(db.execPrepared(txn, SERIES, length)));
+        for (const auto& text : TEXTS) results.push_back(toRows(db.execPrepared(txn, ECHO_TEXT, text)));
+        return results;
+    });
+}
+
+std::vector<Rows> runPipelined()
+{
+    return DatabaseManager::getInstance().executePipeline([](QueryPipeline& pipeline) {
+        for (int number : NUMBERS) pipeline.add(ADD_ONE, number);
+        for (int length : SERIES_LENGTHS) pipeline.add(SERIES, length);
+        for (const auto& text : TEXTS) pipeline.add(ECHO_TEXT, text);
+
+        std::vector<Rows> results;
+        for (size_t i = 0; i < pipeline.size(); ++i) results.push_back(toRows(pipeline.result(i)));
+        return results;
+    });
+}
+
+bool testPipelineMatchesOneAtATime()
+{
+    auto expected = runOneAtATime();
+    auto pipelined = runPipelined();
+    return (pipelined.size() == NUMBERS.size() + SERIES_LENGTHS.size() + TEXTS.size())
+        && (pipelined == expected);
+}
+
+// The manager's pool holds one connection, so this reuses the statements prepared above
+bool testPipelineReusesPreparedStatements()
+{
+    auto first = runPipelined();
+    auto second = runPipelined();
+    return first == second;
+}
+
+bool testPipelineRejectsAddAfterSend()
+{
+    return DatabaseManager::getInstance().executePipeline([](QueryPipeline& pipeline) {
+        pipeline.add(ADD_ONE, 1);
+        pipeline.result(0);  // sends the queue
+        try
+        {
+            pipeline.add(ADD_ONE, 2);
+            return false;
+        }
+        catch (const std::logic_error&)
+        {
+            return pipeline.size() == 1;
+        }
+    });
+}
+
+int main()
+{
+    try
+    {
+        ConnectionPool probe(poolConfig(1, 1, 1000));
+    }
+    catch (const DatabaseException& ex)
+    {
+        std::cout << "[TEST] Database reachable : SKIPPED" << std::endl;
+        std::cout << "  -> " << ex.what() << std::endl;
+        return EXIT_SKIPPED;
+    }
+
+    runTest("Acquire times out when the pool is exhausted", testAcquireTimesOut);
+    runTest("Waiter gets a released connection", testWaiterGetsReleasedConnection);
+    runTest("Pool grows to maximum under load", testPoolGrowsToMaximum);
+    runTest("Idle connections shrink to minimum", testIdleConnectionsShrinkToMinimum);
+    runTest("Stopped pool rejects checkout", testStoppedPoolRejectsCheckout);
+
+    DatabaseManager::getInstance().initialize(poolConfig(1, 1, 5000));
+    runTest("Pipeline matches one-at-a-time execution", testPipelineMatchesOneAtATime);
+    runTest("Pipeline reuses prepared statements", testPipelineReusesPreparedStatements);
+    runTest("Pipeline rejects add after send", testPipelineRejectsAddAfterSend);
+    DatabaseManager::getInstance().shutdown();
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -9,6 +9,105 @@
 namespace sdrs::communication
 {
 
+namespace
+{
+
+const sdrs::database::PreparedStatement CREATE_WITH_STRATEGY("communication_log_create_with_strategy", R"(
+    INSERT INTO communication_logs (
+        account_id, borrower_id, strategy_id,
+        channel_type, message_content, message_status
+    ) VALUES ($1, $2, $3, $4, $5, $6)
+    RETURNING communication_id, created_at, updated_at
+)");
+
+const sdrs::database::PreparedStatement CREATE_WITHOUT_STRATEGY("communication_log_create_without_strategy", R"(
+    INSERT INTO communication_logs (
+        account_id, borrower_id,
+        channel_type, message_content, message_status
+    ) VALUES ($1, $2, $3, $4, $5)
+    RETURNING communication_id, created_at, updated_at
+)");
+
+const sdrs::database::PreparedStatement GET_BY_ID("communication_log_get_by_id", R"(
+    SELECT communication_id, account_id, borrower_id, strategy_id,
+           channel_type, message_content, message_status,
+           sent_at, delivered_at, error_message,
+           created_at, updated_at
+    FROM communication_logs
+    WHERE communication_id = $1
+)");
+
+const sdrs::database::PreparedStatement GET_BY_ACCOUNT_ID("communication_log_get_by_account_id", R"(
+    SELECT communication_id, account_id, borrower_id, strategy_id,
+           channel_type, message_content, message_status,
+           sent_at, delivered_at, error_message,
+           created_at, updated_at
+    FROM communication_logs
+    WHERE account_id = $1
+    ORDER BY created_at DESC
+)");
+
+const sdrs::database::PreparedStatement GET_BY_BORROWER_ID("communication_log_get_by_borrower_id", R"(
+    SELECT communication_id, account_id, borrower_id, strategy_id,
+           channel_type, message_content, message_status,
+           sent_at, delivered_at, error_message,
+           created_at, updated_at
+    FROM communication_logs
+    WHERE borrower_id = $1
+    ORDER BY created_at DESC
+)");
+
+const sdrs::database::PreparedStatement GET_ALL("communication_log_get_all", R"(
+    SELECT communication_id, account_id, borrower_id, strategy_id,
+           channel_type, message_content, message_status,
+           sent_at, delivered_at, error_message,
+           created_at, updated_at
+    FROM communication_logs
+    ORDER BY created_at DESC
+)");
+
+const sdrs::database::PreparedStatement GET_BY_CHANNEL_TYPE("communication_log_get_by_channel_type", R"(
+    SELECT communication_id, account_id, borrower_id, strategy_id,
+           channel_type, message_content, message_status,
+           sent_at, delivered_at, error_message,
+           created_at, updated_at
+    FROM communication_logs
+    WHERE channel_type = $1
+    ORDER BY created_at DESC
+)");
+
+const sdrs::database::PreparedStatement GET_BY_STATUS("communication_log_get_by_status", R"(
+    SELECT communication_id, account_id, borrower_id, strategy_id,
+           channel_type, message_content, message_status,
+           sent_at, delivered_at, error_message,
+           created_at, updated_at
+    FROM communication_logs
+    WHERE message_status = $1
+    ORDER BY created_at DESC
+)");
+
+const sdrs::database::PreparedStatement GET_BY_DATE_RANGE("communication_log_get_by_date_range", R"(
+    SELECT communication_id, account_id, borrower_id, strategy_id,
+           channel_type, message_content, message_status,
+           sent_at, delivered_at, error_message,
+           created_at, updated_at
+    FROM communication_logs
+    WHERE created_at BETWEEN $1 AND $2
+    ORDER BY created_at DESC
+)");
+
+const sdrs::database::PreparedStatement UPDATE("communication_log_update", R"(
+    UPDATE communication_logs
+    SET message_status = $1,
+        updated_at = CURRENT_TIMESTAMP
+    WHERE communication_id = $2
+    RETURNING updated_at
+)");
+
+const sdrs::database::PreparedStatement DELETE_BY_ID("communication_log_delete_by_id", "DELETE FROM communication_logs WHERE communication_id = $1");
+
+}
+
 // Static members for mock mode
 int CommunicationLogRepository::_nextMockId = 1;
 std::vector<CommunicationLog> CommunicationLogRepository::_mockStorage;
@@ -33,19 +132,11 @@ CommunicationLog CommunicationLogRepository::create(const CommunicationLog& log)
     try
     {
         return _dbManager->executeQuery([&](pqxx::work& txn) -> CommunicationLog {
-            std::string sql = R"(
-                INSERT INTO communication_logs (
-                    account_id, borrower_id, strategy_id,
-                    channel_type, message_content, message_status
-                ) VALUES ($1, $2, $3, $4, $5, $6)
-                RETURNING communication_id, created_at, updated_at
-            )";
-            
             pqxx::result result;
             
             if (log.getStrategyId().has_value())
             {
-                result = txn.exec_params(sql,
+                result = _dbManager->execPrepared(txn, CREATE_WITH_STRATEGY,
                     log.getAccountId(),
                     log.getBorrowerId(),
                     log.getStrategyId().value(),
@@ -56,16 +147,8 @@ CommunicationLog CommunicationLogRepository::create(const CommunicationLog& log)
             }
             else
             {
-                // Build a different SQL without strategy_id
-                std::string sqlNoStrategy = R"(
-                    INSERT INTO communication_logs (
-                        account_id, borrower_id,
-                        channel_type, message_content, message_status
-                    ) VALUES ($1, $2, $3, $4, $5)
-                    RETURNING communication_id, created_at, updated_at
-                )";
-                
-                result = txn.exec_params(sqlNoStrategy,
+                // Separate statement without strategy_id
+                result = _dbManager->execPrepared(txn, CREATE_WITHOUT_STRATEGY,
                     log.getAccountId(),
                     log.getBorrowerId(),
                     CommunicationLog::channelTypeToString(log.getChannelType()),
@@ -103,17 +186,8 @@ CommunicationLog CommunicationLogRepository::getById(int communicationId)
     
     try
     {
-        return _dbManager->executeQuery([&](pqxx::work& txn) -> CommunicationLog {
-            std::string sql = R"(
-                SELECT communication_id, account_id, borrower_id, strategy_id,
-                       channel_type, message_content, message_status,
-                       sent_at, delivered_at, error_message,
-                       created_at, updated_at
-                FROM communication_logs
-                WHERE communication_id = $1
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, communicationId);
+        return _dbManager->executeRead([&](pqxx::nontransaction& txn) -> CommunicationLog {
+            pqxx::result result = _dbManager->execPrepared(txn, GET_BY_ID, communicationId);
             
             if (result.empty())
             {
@@ -139,18 +213,8 @@ std::vector<CommunicationLog> CommunicationLogRepository::getByAccountId(int acc
     
     try
     {
-        return _dbManager->executeQuery([&](pqxx::work& txn) -> std::vector<CommunicationLog> {
-            std::string sql = R"(
-                SELECT communication_id, account_id, borrower_id, strategy_id,
-                       channel_type, message_content, message_status,
-                       sent_at, delivered_at, error_message,
-                       created_at, updated_at
-                FROM communication_logs
-                WHERE account_id = $1
-                ORDER BY created_at DESC
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, accountId);
+        return _dbManager->executeRead([&](pqxx::nontransaction& txn) -> std::vector<CommunicationLog> {
+            pqxx::result result = _dbManager->execPrepared(txn, GET_BY_ACCOUNT_ID, accountId);
             
             std::vector<CommunicationLog> logs;
             for (const auto& row : result)
@@ -174,18 +238,8 @@ std::vector<CommunicationLog> CommunicationLogRepository::getByBorrowerId(int bo
     
     try
     {
-        return _dbManager->executeQuery([&](pqxx::work& txn) -> std::vector<CommunicationLog> {
-            std::string sql = R"(
-                SELECT communication_id, account_id, borrower_id, strategy_id,
-                       channel_type, message_content, message_status,
-                       sent_at, delivered_at, error_message,
-                       created_at, updated_at
-                FROM communication_logs
-                WHERE borrower_id = $1
-                ORDER BY created_at DESC
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, borrowerId);
+        return _dbManager->executeRead([&](pqxx::nontransaction& txn) -> std::vector<CommunicationLog> {
+            pqxx::result result = _dbManager->execPrepared(txn, GET_BY_BORROWER_ID, borrowerId);
             
             std::vector<CommunicationLog> logs;
             for (const auto& row : result)
@@ -209,17 +263,8 @@ std::vector<CommunicationLog> CommunicationLogRepository::getAll()
     
     try
     {
-        return _dbManager->executeQuery([&](pqxx::work& txn) -> std::vector<CommunicationLog> {
-            std::string sql = R"(
-                SELECT communication_id, account_id, borrower_id, strategy_id,
-                       channel_type, message_content, message_status,
-                       sent_at, delivered_at, error_message,
-                       created_at, updated_at
-                FROM communication_logs
-                ORDER BY created_at DESC
-            )";
-            
-            pqxx::result result = txn.exec_params(sql);
+        return _dbManager->executeRead([&](pqxx::nontransaction& txn) -> std::vector<CommunicationLog> {
+            pqxx::result result = _dbManager->execPrepared(txn, GET_ALL);
             
             std::vector<CommunicationLog> logs;
             for (const auto& row : result)
@@ -254,18 +299,8 @@ std::vector<CommunicationLog> CommunicationLogRepository::getByChannelType(Chann
     
     try
     {
-        return _dbManager->executeQuery([&](pqxx::work& txn) -> std::vector<CommunicationLog> {
-            std::string sql = R"(
-                SELECT communication_id, account_id, borrower_id, strategy_id,
-                       channel_type, message_content, message_status,
-                       sent_at, delivered_at, error_message,
-                       created_at, updated_at
-                FROM communication_logs
-                WHERE channel_type = $1
-                ORDER BY created_at DESC
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, CommunicationLog::channelTypeToString(channelType));
+        return _dbManager->executeRead([&](pqxx::nontransaction& txn) -> std::vector<CommunicationLog> {
+            pqxx::result result = _dbManager->execPrepared(txn, GET_BY_CHANNEL_TYPE, CommunicationLog::channelTypeToString(channelType));
             
             std::vector<CommunicationLog> logs;
             for (const auto& row : result)
@@ -300,18 +335,8 @@ std::vector<CommunicationLog> CommunicationLogRepository::getByStatus(MessageSta
     
     try
     {
-        return _dbManager->executeQuery([&](pqxx::work& txn) -> std::vector<CommunicationLog> {
-            std::string sql = R"(
-                SELECT communication_id, account_id, borrower_id, strategy_id,
-                       channel_type, message_content, message_status,
-                       sent_at, delivered_at, error_message,
-                       created_at, updated_at
-                FROM communication_logs
-                WHERE message_status = $1
-                ORDER BY created_at DESC
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, CommunicationLog::messageStatusToString(status));
+        return _dbManager->executeRead([&](pqxx::nontransaction& txn) -> std::vector<CommunicationLog> {
+            pqxx::result result = _dbManager->execPrepared(txn, GET_BY_STATUS, CommunicationLog::messageStatusToString(status));
             
             std::vector<CommunicationLog> logs;
             for (const auto& row : result)
@@ -349,17 +374,7 @@ std::vector<CommunicationLog> CommunicationLogRepository::getByDateRange(
     
     try
     {
-        return _dbManager->executeQuery([&](pqxx::work& txn) -> std::vector<CommunicationLog> {
-            std::string sql = R"(
-                SELECT communication_id, account_id, borrower_id, strategy_id,
-                       channel_type, message_content, message_status,
-                       sent_at, delivered_at, error_message,
-                       created_at, updated_at
-                FROM communication_logs
-                WHERE created_at BETWEEN $1 AND $2
-                ORDER BY created_at DESC
-            )";
-            
+        return _dbManager->executeRead([&](pqxx::nontransaction& txn) -> std::vector<CommunicationLog> {
             auto fromTime = std::chrono::system_clock::to_time_t(from);
             auto toTime = std::chrono::system_clock::to_time_t(to);
             
@@ -367,7 +382,7 @@ std::vector<CommunicationLog> CommunicationLogRepository::getByDateRange(
             std::strftime(fromStr, sizeof(fromStr), "%Y-%m-%d %H:%M:%S", std::localtime(&fromTime));
             std::strftime(toStr, sizeof(toStr), "%Y-%m-%d %H:%M:%S", std::localtime(&toTime));
             
-            pqxx::result result = txn.exec_params(sql, fromStr, toStr);
+            pqxx::result result = _dbManager->execPrepared(txn, GET_BY_DATE_RANGE, fromStr, toStr);
             
             std::vector<CommunicationLog> logs;
             for (const auto& row : result)
@@ -417,15 +432,7 @@ CommunicationLog CommunicationLogRepository::update(const CommunicationLog& log)
             }
             
             // Simple update - just status for now
-            std::string sql = R"(
-                UPDATE communication_logs
-                SET message_status = $1,
-                    updated_at = CURRENT_TIMESTAMP
-                WHERE communication_id = $2
-                RETURNING updated_at
-            )";
-            
-            pqxx::result result = txn.exec_params(sql,
+            pqxx::result result = _dbManager->execPrepared(txn, UPDATE,
                 CommunicationLog::messageStatusToString(log.getMessageStatus()),
                 log.getCommunicationId()
             );
@@ -467,8 +474,7 @@ bool CommunicationLogRepository::deleteById(int communicationId)
     try
     {
         return _dbManager->executeQuery([&](pqxx::work& txn) -> bool {
-            std::string sql = "DELETE FROM communication_logs WHERE communication_id = $1";
-            pqxx::result result = txn.exec_params(sql, communicationId);
+            pqxx::result result = _dbManager->execPrepared(txn, DELETE_BY_ID, communicationId);
             return result.affected_rows() > 0;
         });
     }
@@ -71,6 +71,7 @@ CREATE INDEX idx_borrowers_email ON borrowers(email);
 CREATE INDEX idx_borrowers_is_active ON borrowers(is_active);
 CREATE INDEX idx_borrowers_created_at ON borrowers(created_at DESC);
 CREATE INDEX idx_borrowers_phone ON borrowers(phone_number) WHERE phone_number IS NOT NULL;
+CREATE INDEX idx_borrowers_updated_at ON borrowers(updated_at);
 
 -- Function to auto-update updated_at timestamp
 CREATE OR REPLACE FUNCTION update_updated_at_column()
@@ -145,6 +146,7 @@ CREATE INDEX idx_loan_accounts_borrower ON loan_accounts(borrower_id);
 CREATE INDEX idx_loan_accounts_status ON loan_accounts(account_status);
 CREATE INDEX idx_loan_accounts_past_due ON loan_accounts(days_past_due) WHERE days_past_due > 0;
 CREATE INDEX idx_loan_accounts_created_at ON loan_accounts(created_at DESC);
+CREATE INDEX idx_loan_accounts_updated_at ON loan_accounts(updated_at);
 
 CREATE TRIGGER trigger_loan_accounts_updated_at
     BEFORE UPDATE ON loan_accounts
@@ -199,6 +201,7 @@ CREATE TABLE IF NOT EXISTS payment_history (
 CREATE INDEX idx_payment_history_account ON payment_history(account_id);
 CREATE INDEX idx_payment_history_status ON payment_history(payment_status);
 CREATE INDEX idx_payment_history_date ON payment_history(payment_date DESC);
+CREATE INDEX idx_payment_history_updated_at ON payment_history(updated_at);
 
 CREATE TRIGGER trigger_payment_history_updated_at
     BEFORE UPDATE ON payment_history
@@ -236,7 +239,7 @@ CREATE TABLE IF NOT EXISTS risk_assessments (
     )
 );
 
-CREATE INDEX idx_risk_assessments_account ON risk_assessments(account_id);
+CREATE INDEX idx_risk_assessments_account ON risk_assessments(account_id, assessment_date DESC);
 CREATE INDEX idx_risk_assessments_risk_level ON risk_assessments(risk_level);
 CREATE INDEX idx_risk_assessments_date ON risk_assessments(assessment_date DESC);
 
@@ -454,6 +457,9 @@ CREATE TABLE IF NOT EXISTS ml_models (
     hyperparameters JSONB,
     metrics JSONB, -- accuracy, precision, recall, f1_score, silhouette_score
     
+    artifact_path VARCHAR(500), -- binary model file loaded (mmap) by the service
+    format_version INTEGER, -- binary layout version of the artifact
+    
     trained_at TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP,
     updated_at TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP,
     is_active BOOLEAN DEFAULT false
@@ -477,5 +483,7 @@ COMMENT ON COLUMN ml_models.model_type IS 'Type of ML algorithm: "RandomForest"
 COMMENT ON COLUMN ml_models.version IS 'Model version string (e.g., "1.0.0", "2.1.3")';
 COMMENT ON COLUMN ml_models.hyperparameters IS 'JSONB storing model hyperparameters (e.g., {"n_estimators": 100, "max_depth": 10, "k_clusters": 5})';
 COMMENT ON COLUMN ml_models.metrics IS 'JSONB storing model performance metrics (e.g., {"accuracy": 0.89, "precision": 0.85, "recall": 0.92, "silhouette_score": 0.67})';
+COMMENT ON COLUMN ml_models.artifact_path IS 'Path of the binary model artifact; risk-assessment-service memory-maps the active one at startup instead of retraining';
+COMMENT ON COLUMN ml_models.format_version IS 'Binary model file layout version (MODEL_FORMAT_VERSION); artifacts with another version are rejected on load';
 COMMENT ON COLUMN ml_models.trained_at IS 'Timestamp when model was trained';
 COMMENT ON COLUMN ml_models.is_active IS 'Whether this model version is currently in production (only one active model per type)';
\ No newline at end of file
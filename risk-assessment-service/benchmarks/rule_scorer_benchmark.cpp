@@ -0,0 +1,230 @@
+// rule_scorer_benchmark.cpp - Compares RuleBasedScorer against the if/else rule chain it replaced
+//
+// Usage: rule_scorer_benchmark [rows] [repeats]
+// Exits non-zero if any score differs from the reference implementation.
+
+#include "../include/models/RuleBasedScorer.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace sdrs::constants;
+using namespace sdrs::constants::risk;
+using namespace sdrs::risk;
+
+namespace
+{
+
+// Reference: the scorer as it was before the rule tables, kept verbatim
+double legacyEmploymentRisk(EmploymentStatus status)
+{
+    switch (status)
+    {
+    case EmploymentStatus::Employed:
+    case EmploymentStatus::Contract:
+    case EmploymentStatus::SelfEmployed:
+        return 0.0;
+    case EmploymentStatus::PartTime:
+    case EmploymentStatus::Student:
+        return 0.05;
+    case EmploymentStatus::Unemployed:
+    case EmploymentStatus::Retired:
+    case EmploymentStatus::None:
+        return 0.10;
+    default:
+        return 0.10;
+    }
+}
+
+double legacyAccountRisk(AccountStatus status)
+{
+    switch (status)
+    {
+    case AccountStatus::PaidOff:
+    case AccountStatus::Current:
+        return 0.0;
+    case AccountStatus::Partial:
+        return 0.02;
+    case AccountStatus::Settled:
+        return 0.04;
+    case AccountStatus::Delinquent:
+        return 0.06;
+    case AccountStatus::Default:
+    case AccountStatus::ChargedOff:
+        return 0.10;
+    default:
+        return 0.10;
+    }
+}
+
+double legacyRuleBasedScore(const RiskFeatures& features)
+{
+    double score = 0.0;
+
+    if (features.daysPastDue >= DPD_HIGH_THRESHOLD)
+    {
+        score += 0.40;
+    }
+    else if (features.daysPastDue >= DPD_MEDIUM_THRESHOLD)
+    {
+        score += 0.30;
+    }
+    else if (features.daysPastDue >= DPD_LOW_THRESHOLD)
+    {
+        score += 0.20;
+    }
+    else 
+    {
+        score += features.daysPastDue / DPD_DEFAULT_THRESHOLD * 0.20;
+    }
+    
+    score += std::min(0.30, features.numberOfMissedPayments * 0.10);
+    
+    double debtRatio = features.remainingAmount.getAmount() / (features.loanAmount.getAmount() + 1e-6);
+    score += debtRatio * 0.20;
+    
+    // If no income (0 VND) and has debt -> VERY HIGH RISK
+    double monthlyIncome = features.monthlyIncome.getAmount();
+    // Calculate minimum monthly payment: (remaining * (1 + interest)) / 12 months
+    double monthlyPaymentRequired = features.remainingAmount.getAmount() * (1.0 + features.interestRate) / 12.0;
+    
+    if (monthlyIncome <= 0 && features.remainingAmount.getAmount() > 0) {
+        // No income + has debt = cannot repay!
+        score += 0.35;  // Major risk factor
+    } else if (monthlyIncome > 0) {
+        // Debt-to-Income ratio (monthly payment / monthly income)
+        double dti = monthlyPaymentRequired / (monthlyIncome + 1e-6);
+        if (dti > 0.5) {
+            score += 0.25;  // Payment > 50% of income
+        } else if (dti > 0.35) {
+            score += 0.15;  // Payment 35-50% of income
+        } else if (dti > 0.20) {
+            score += 0.10;  // Payment 20-35% of income (borderline)
+        } else if (dti > 0.10) {
+            score += 0.05;  // Payment 10-20% of income (manageable)
+        }
+        // dti <= 0.10 is very healthy, no additional risk
+    }
+    
+    // Age factor: younger borrowers (18-25) and older borrowers (65+) have higher risk
+    if (features.age > 0) {
+        if (features.age < 25) {
+            score += 0.10;  // Young, less financial stability
+        } else if (features.age >= 65) {
+            score += 0.08;  // Older, income concerns
+        } else if (features.age >= 35 && features.age <= 50) {
+            score -= 0.05;  // Prime working age, lower risk
+        }
+    }
+    
+    // Account age factor: new accounts are riskier
+    if (features.accountAgeMonths > 0) {
+        if (features.accountAgeMonths < 3) {
+            score += 0.10;  // Very new account (< 3 months)
+        } else if (features.accountAgeMonths < 6) {
+            score += 0.05;  // New account (3-6 months)
+        }
+        // 6+ months is established, no additional risk
+    }
+    
+    score += legacyEmploymentRisk(features.employmentStatus);
+    score += legacyAccountRisk(features.accountStatus);
+    
+    return std::min(1.0, score);
+}
+
+std::vector<RiskFeatures> generateAccounts(size_t count)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> dpd(0, 200);
+    std::uniform_int_distribution<int> missed(0, 8);
+    std::uniform_int_distribution<int> age(0, 90);
+    std::uniform_int_distribution<int> accountAge(0, 48);
+    std::uniform_int_distribution<int> employment(0, static_cast<int>(EmploymentStatus::None));
+    std::uniform_int_distribution<int> status(0, static_cast<int>(AccountStatus::Settled));
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    std::vector<RiskFeatures> accounts(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto& row = accounts[i];
+        row.accountId = static_cast<int>(i) + 1;
+        row.borrowerId = static_cast<int>(i) + 1;
+        row.loanAmount = sdrs::money::Money(1e7 + unit(rng) * 4e8);
+        row.remainingAmount = sdrs::money::Money(row.loanAmount.getAmount() * unit(rng));
+        row.interestRate = 0.05 + unit(rng) * 0.25;
+        row.daysPastDue = dpd(rng);
+        row.numberOfMissedPayments = missed(rng);
+        row.age = age(rng);
+        row.accountAgeMonths = accountAge(rng);
+        row.monthlyIncome = sdrs::money::Money(unit(rng) < 0.1 ? 0.0 : unit(rng) * 3e7);
+        row.employmentStatus = static_cast<EmploymentStatus>(employment(rng));
+        row.accountStatus = static_cast<AccountStatus>(status(rng));
+    }
+    return accounts;
+}
+
+template<typename Body>
+double nanosPerRow(size_t rows, int repeats, Body body)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r)
+    {
+        body();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (static_cast<double>(rows) * repeats);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    size_t rows = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 50;
+    if ((rows == 0)
+        || (repeats <= 0))
+    {
+        std::cerr << "Usage: rule_scorer_benchmark [rows] [repeats] (both must be positive)\n";
+        return EXIT_FAILURE;
+    }
+
+    auto accounts = generateAccounts(rows);
+    std::vector<double> expected(rows);
+    std::vector<double> actual(rows);
+
+    for (size_t i = 0; i < rows; ++i)
+    {
+        expected[i] = legacyRuleBasedScore(accounts[i]);
+    }
+    RuleBasedScorer::scoreBatch(accounts, actual);
+    size_t mismatches = 0;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        mismatches += (expected[i] != actual[i]) || (RuleBasedScorer::score(accounts[i]) != expected[i]);
+    }
+
+    // The checksum keeps the optimizer from discarding the loops
+    volatile double checksum = 0.0;
+    double legacy = nanosPerRow(rows, repeats, [&] {
+        for (size_t i = 0; i < rows; ++i) expected[i] = legacyRuleBasedScore(accounts[i]);
+        checksum = checksum + expected[rows / 2];
+    });
+    double single = nanosPerRow(rows, repeats, [&] {
+        for (size_t i = 0; i < rows; ++i) actual[i] = RuleBasedScorer::score(accounts[i]);
+        checksum = checksum + actual[rows / 2];
+    });
+    double batch = nanosPerRow(rows, repeats, [&] {
+        RuleBasedScorer::scoreBatch(accounts, actual);
+        checksum = checksum + actual[rows / 2];
+    });
+
+    std::cout << "rows=" << rows << " repeats=" << repeats << " mismatches=" << mismatches << "\n"
+        << "legacy if/else:        " << legacy << " ns/row\n"
+        << "RuleBasedScorer::score " << single << " ns/row (" << legacy / single << "x)\n"
+        << "scoreBatch:            " << batch << " ns/row (" << legacy / batch << "x)\n";
+
+    return mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,84 @@
+// CompactForest.h - Reduced-precision inference copy of a compiled forest, small enough to stay cache resident
+
+#ifndef SDRS_RISK_COMPACT_FOREST_H
+#define SDRS_RISK_COMPACT_FOREST_H
+
+#include "RandomForest.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace sdrs::risk
+{
+
+enum class ModelPrecision
+{
+    Float64,    // the FlatForest itself, 28 bytes per node
+    Float32,    // float thresholds and leaves, 12 bytes per node; inputs within float rounding of a threshold may flip
+    Quantized16 // thresholds replaced by per-feature cut-point indices, 8 bytes per node; splits are exact
+};
+
+// Both node layouts are pre-order, so a split's left child is always the next node and only the
+// right child index is stored
+struct CompactNode
+{
+    float value;         // threshold, or the leaf value
+    uint32_t right;
+    uint16_t feature;    // COMPACT_LEAF_FEATURE on leaves
+};
+
+struct QuantizedNode
+{
+    uint32_t payload;    // right child index; on leaves the bits of the float leaf value
+    uint16_t feature;    // COMPACT_LEAF_FEATURE on leaves
+    uint16_t bin;        // goes left when the input's bin <= bin
+};
+
+static_assert(sizeof(CompactNode) == 12);
+static_assert(sizeof(QuantizedNode) == 8);
+
+inline constexpr uint16_t COMPACT_LEAF_FEATURE = 0xFFFF;
+
+// Built from a FlatForestView; inference only, never trained or saved.
+// Quantized16: a value x falls in bin b = number of the feature's cut points <= x. Since every
+// threshold is a cut point, x < cutPoint[k] exactly when b <= k, so each input is binned once per
+// row and the tree walk compares 16-bit integers.
+class CompactForest
+{
+private:
+    static constexpr size_t MAX_FEATURES = 64;  // per-row bins live on the stack
+
+    ModelPrecision _precision;
+    size_t _numFeatures;
+    std::vector<uint32_t> _treeRoots;
+    std::vector<CompactNode> _nodes;             // Float32
+    std::vector<QuantizedNode> _quantizedNodes;  // Quantized16
+    std::vector<double> _cutPoints;              // Quantized16: sorted distinct thresholds, feature by feature
+    std::vector<uint32_t> _cutOffsets;           // feature f owns _cutPoints[_cutOffsets[f], _cutOffsets[f + 1])
+
+public:
+    // precision must be Float32 or Quantized16
+    CompactForest(const FlatForestView& forest, size_t numFeatures, ModelPrecision precision);
+
+    double predict(const double* features) const;  // average over all trees
+
+    // Column-major input like FlatForestView::predictBatch(); writes numRows averages to out
+    void predictBatch(const double* columns, size_t numRows, double* out) const;
+
+    ModelPrecision getPrecision() const;
+    size_t getNodeCount() const;
+    size_t getMemoryBytes() const;  // nodes, tree roots and cut points
+
+    static std::string precisionToString(ModelPrecision precision);
+    static ModelPrecision stringToPrecision(const std::string& name);  // "float64", "float32" or "uint16"
+    static size_t flatMemoryBytes(const FlatForestView& forest);      // same measure for the double forest
+
+private:
+    uint32_t appendTree(const FlatForestView& forest, int flatNode);  // pre-order copy; returns the new index
+    uint16_t binOf(size_t feature, double value) const;
+    double predictTree(size_t treeIndex, const double* features, const uint16_t* bins) const;
+};
+
+}
+
+#endif
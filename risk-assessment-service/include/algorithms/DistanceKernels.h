@@ -0,0 +1,32 @@
+// DistanceKernels.h - Squared distances from one point to every centroid, SIMD kernel picked at runtime
+
+#ifndef SDRS_RISK_DISTANCE_KERNELS_H
+#define SDRS_RISK_DISTANCE_KERNELS_H
+
+#include <cstddef>
+#include <vector>
+
+namespace sdrs::risk
+{
+
+// Centroid blocks are padded to this many lanes (one AVX-512 register of doubles)
+inline constexpr size_t DISTANCE_KERNEL_LANES = 8;
+
+// Centroids are laid out feature-major: feature f of centroid c is centroids[f * stride + c], with
+// stride a multiple of DISTANCE_KERNEL_LANES. One vector load then holds the same feature of 4 or 8
+// centroids, so a point is compared against all of them at once. Writes `stride` values to out;
+// entries past the real centroid count belong to padding and are ignored by callers.
+using SquaredDistancesFn = void (*)(const double* point, size_t numFeatures, const double* centroids, size_t stride, double* out);
+
+struct DistanceKernel
+{
+    const char* name;  // "avx512", "avx2" or "portable"
+    SquaredDistancesFn squaredDistances;
+};
+
+const DistanceKernel& getDistanceKernel();  // best kernel this CPU supports, chosen once
+const std::vector<DistanceKernel>& getSupportedDistanceKernels();  // best first; for tests and benchmarks
+
+}
+
+#endif
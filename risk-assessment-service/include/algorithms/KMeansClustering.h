@@ -6,10 +6,15 @@
 #include "../../../common/include/utils/Constants.h"
 #include <vector>
 #include <random>
+#include <string>
+#include <cstdint>
+#include <functional>
 
 namespace sdrs::risk
 {
 
+class WorkerPool;
+
 // Cluster assignment result
 struct ClusterResult
 {
@@ -18,24 +23,55 @@ struct ClusterResult
     std::vector<double> centroid;
 };
 
+// Contiguous row-major points: feature f of point i is values[i * numFeatures + f]
+struct PointMatrix
+{
+    size_t numRows = 0;
+    size_t numFeatures = 0;
+    std::vector<double> values;
+
+    void assign(const std::vector<std::vector<double>>& X);  // throws if rows differ in length
+    const double* row(size_t i) const;
+};
+
 // Groups borrowers into k clusters based on risk features
 class KMeansClustering
 {
 private:
     int _k;
     int _maxIterations;
+    int _iterations;   // Lloyd iterations used by the last train()
+    int _numThreads;   // 0 = std::thread::hardware_concurrency()
     bool _isTrained;
+    double _inertia;
 
     std::vector<std::vector<double>> _centroids;
     std::vector<int> _labels;
 
+    // Copy of _centroids for the distance kernels: feature-major, padded to DISTANCE_KERNEL_LANES
+    std::vector<double> _centroidBlock;
+    size_t _centroidStride;
+
+    // Hamerly bounds, kept only while training: no point can be closer to any other
+    // centroid than _lowerBounds[i], nor farther from its own than _upperBounds[i]
+    std::vector<double> _upperBounds;
+    std::vector<double> _lowerBounds;
+    std::vector<double> _centroidShifts;  // how far each centroid moved in the last update
+
+    std::vector<double> _centroidCounts;  // points absorbed per centroid across partialFit() calls
+    PointMatrix _batchPoints;             // partialFit() staging buffer, reused across batches
+
     mutable std::mt19937 _randomEngine;
+    WorkerPool* _workers;  // set only while train() or partialFit() runs; forEachRange() uses it when set
 
 public:
     KMeansClustering(int k = sdrs::constants::risk::KMEANS_NUM_CLUSTERS, int maxIterations = sdrs::constants::risk::KMEANS_MAX_ITERATIONS);
     ~KMeansClustering() = default;
 
     void train(const std::vector<std::vector<double>>& X);           // find k centroids
+    void train(const PointMatrix& X);
+    void partialFit(const std::vector<std::vector<double>>& batch);  // mini-batch update; the first batch seeds the centroids, getLabels() holds the last batch
+    void partialFit(const PointMatrix& batch);
     ClusterResult predict(const std::vector<double>& points) const;  // assign to nearest cluster
     std::vector<int> predictBatch(const std::vector<std::vector<double>>& X) const;
 
@@ -45,13 +81,33 @@ public:
     const std::vector<std::vector<double>>& getCentroids() const;
     const std::vector<int>& getLabels() const;
     double getInertia() const;  // sum of squared distances (lower = better fit)
+    int getIterations() const;
+    void setSeed(uint32_t seed);
+    void setNumThreads(int numThreads);
+
+    void saveModel(const std::string& path) const;  // versioned binary artifact (centroids only)
+    void loadModel(const std::string& path);
 
 private:
-    void initializeCentroids(const std::vector<std::vector<double>>& X);
-    void assignClusters(const std::vector<std::vector<double>>& X);
-    bool updateCentroids(const std::vector<std::vector<double>>& X);
-    double euclideanDistance(const std::vector<double>& a, const std::vector<double>& b) const;
-    int findNearestCentroid(const std::vector<double>& points) const;
+    void initializeCentroids(const PointMatrix& X);  // k-means++ seeding
+    void assignClusters(const PointMatrix& X);  // skips points whose bounds prove the label unchanged
+    bool updateCentroids(const PointMatrix& X);
+    void computeInertia(const PointMatrix& X);
+    void refreshCentroidBlock();  // call after every change to _centroids
+
+    static double squaredDistance(const double* a, const double* b, size_t numFeatures);
+    static double euclideanDistance(const std::vector<double>& a, const std::vector<double>& b);
+
+    // Both scans run the SIMD kernel over all centroids; `distances` is scratch of _centroidStride doubles
+    int findNearestCentroid(const double* point, double* distances) const;
+    // Also returns the nearest distance and the distance to the second nearest
+    int findTwoNearestCentroids(const double* point, double* distances, double& nearestDistance, double& secondDistance) const;
+
+    // Splits [0, count) into one contiguous range per worker and runs body(worker, begin, end) on each,
+    // on _workers when set and on short-lived threads otherwise; rethrows the first failure.
+    // workerCount() tells callers how many per-worker buffers to allocate.
+    int workerCount(size_t count) const;
+    void forEachRange(size_t count, const std::function<void(int, size_t, size_t)>& body) const;
 
 };
 
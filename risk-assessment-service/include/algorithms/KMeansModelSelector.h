@@ -0,0 +1,62 @@
+// KMeansModelSelector.h - Picks the cluster count by training every k in a range, with restarts, concurrently
+
+#ifndef SDRS_RISK_KMEANS_MODEL_SELECTOR_H
+#define SDRS_RISK_KMEANS_MODEL_SELECTOR_H
+
+#include "KMeansClustering.h"
+
+namespace sdrs::risk
+{
+
+// Best of the restarts for one k
+struct KCandidate
+{
+    int k;
+    double inertia;
+    double silhouette;  // mean over the sample, -1 to 1 (higher = better separated)
+    int iterations;
+};
+
+struct KSelectionResult
+{
+    KMeansClustering model;               // trained with bestK on the full data
+    int bestK = 0;                        // highest silhouette
+    int elbowK = 0;                       // knee of the inertia curve, reported for comparison
+    size_t silhouetteSamples = 0;
+    std::vector<KCandidate> candidates;   // ascending k
+};
+
+class KMeansModelSelector
+{
+private:
+    int _minK;
+    int _maxK;
+    int _restarts;
+    size_t _silhouetteSamples;
+    uint32_t _seed;
+    int _numThreads;   // 0 = std::thread::hardware_concurrency()
+
+public:
+    // maxK and restarts are capped at KMEANS_AUTO_K_LIMIT and KMEANS_AUTO_RESTARTS_LIMIT
+    KMeansModelSelector(
+        int minK = sdrs::constants::risk::KMEANS_AUTO_MIN_K,
+        int maxK = sdrs::constants::risk::KMEANS_AUTO_MAX_K,
+        int restarts = sdrs::constants::risk::KMEANS_AUTO_RESTARTS);
+
+    // One run per (k, restart) across the worker threads; each run trains single-threaded.
+    // k stops short of the row count when maxK would reach it.
+    KSelectionResult select(const PointMatrix& X) const;
+
+public:
+    void setSeed(uint32_t seed);
+    void setNumThreads(int numThreads);
+    void setSilhouetteSamples(size_t samples);
+
+private:
+    static double silhouette(const PointMatrix& X, const std::vector<size_t>& sample, const std::vector<int>& labels, int k);
+    static int findElbow(const std::vector<KCandidate>& candidates);
+};
+
+}
+
+#endif
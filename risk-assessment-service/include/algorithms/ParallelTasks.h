@@ -0,0 +1,58 @@
+// ParallelTasks.h - Fans independent tasks out over worker threads, short-lived or pooled
+
+#ifndef SDRS_RISK_PARALLEL_TASKS_H
+#define SDRS_RISK_PARALLEL_TASKS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sdrs::risk
+{
+
+// Runs task(0..numTasks-1) on up to numThreads workers (0 = std::thread::hardware_concurrency()),
+// the calling thread among them. Workers pull the next index as they finish, so uneven tasks
+// balance out. Rethrows the first failure once every worker has stopped.
+void runParallel(int numTasks, int numThreads, const std::function<void(int)>& task);
+
+// Same contract as runParallel(), but the threads are started once and reused by every run(),
+// for algorithms that fan out many short phases in a row. A pool of one starts no thread.
+class WorkerPool
+{
+private:
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _wake;  // a new run() or shutdown
+    std::condition_variable _idle;  // the last worker finished the current run()
+
+    const std::function<void(int)>* _task;
+    int _numTasks;
+    std::atomic<int> _nextTask;
+    uint64_t _generation;  // bumped by each run(); workers wait for it to move
+    int _busyWorkers;
+    std::exception_ptr _error;
+    bool _stopping;
+
+public:
+    explicit WorkerPool(int numThreads);  // 0 = std::thread::hardware_concurrency()
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int size() const;  // threads taking part in run(), the caller included
+    void run(int numTasks, const std::function<void(int)>& task);  // not reentrant
+
+private:
+    void workerLoop();
+    void drain(const std::function<void(int)>& task, int numTasks);
+};
+
+}
+
+#endif
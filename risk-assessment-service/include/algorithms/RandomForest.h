@@ -8,10 +8,21 @@
 #include <memory>
 #include <random>
 #include <map>
+#include <string>
+#include <span>
+#include <cstdint>
+#include <functional>
 
 namespace sdrs::risk
 {
 
+// How trees search for split thresholds during training
+enum class SplitMode
+{
+    Exact,     // every distinct value, presorted per tree
+    Histogram  // features quantized once into at most RF_HISTOGRAM_MAX_BINS bins
+};
+
 struct TreeNode
 {
     int featureIndex;
@@ -26,6 +37,78 @@ struct TreeNode
     bool isLeaf() const;
 };
 
+// Read-only view of a compiled forest (structure-of-arrays). Points either into a FlatForest
+// or straight into a memory-mapped model file; inference only ever goes through a view.
+struct FlatForestView
+{
+    const int* featureIndices = nullptr;  // RF_LEAF_FEATURES_INDEX marks a leaf
+    const double* thresholds = nullptr;
+    const int* leftChildren = nullptr;    // absolute node offsets
+    const int* rightChildren = nullptr;
+    const double* leafValues = nullptr;
+    const int* treeRoots = nullptr;
+    size_t nodeCount = 0;
+    size_t numTrees = 0;
+
+    bool empty() const;
+
+    double predictTree(size_t treeIndex, const double* features) const;  // iterative walk, no recursion
+    double predict(const double* features) const;  // average over all trees
+
+    // Column-major input: feature f of row i is columns[f * numRows + i]; writes numRows averages to out
+    void predictBatch(const double* columns, size_t numRows, double* out) const;
+};
+
+// Owning storage for a compiled forest
+// Nodes of every tree are stored contiguously in pre-order, each tree starting at treeRoots[t]
+struct FlatForest
+{
+    std::vector<int> featureIndices;
+    std::vector<double> thresholds;
+    std::vector<int> leftChildren;
+    std::vector<int> rightChildren;
+    std::vector<double> leafValues;
+    std::vector<int> treeRoots;
+
+    void clear();
+    bool empty() const;
+    size_t getNodeCount() const;
+    int appendNode();  // returns offset of the new node
+    FlatForestView view() const;
+};
+
+// Immutable column-major copy of the training features, shared by every tree (exact mode)
+struct FeatureMatrix
+{
+    size_t numRows = 0;
+    size_t numFeatures = 0;
+    std::vector<double> values;                // column-major: values[f * numRows + i]
+    std::vector<std::vector<int>> sortedRows;  // row indices ordered by each feature, sorted once per forest
+
+    void build(const std::vector<std::vector<double>>& X);
+    const double* column(size_t feature) const;
+};
+
+// Feature matrix quantized once for histogram training (1 byte per value instead of 8)
+struct BinnedFeatures
+{
+    size_t numRows = 0;
+    size_t numFeatures = 0;
+    std::vector<uint8_t> bins;                    // column-major: bins[f * numRows + i]
+    std::vector<std::vector<double>> cutPoints;   // value < cutPoints[f][b]  <=>  bin <= b
+
+    void build(const std::vector<std::vector<double>>& X, int maxBins = sdrs::constants::risk::RF_HISTOGRAM_MAX_BINS);
+    const uint8_t* column(size_t feature) const;
+};
+
+// Per-bin label statistics of one node; a node holds one for every (feature, bin) pair
+struct HistogramBin
+{
+    double count = 0.0;
+    double sum = 0.0;
+    double sumSquared = 0.0;
+};
+
 class DecisionTree
 {
 private:
@@ -34,83 +117,159 @@ private:
     int _minSamplesSplit;
     int _currentDepth;
     
-    mutable std::mt19937 _randomEngine;
-    mutable std::vector<double> _tempFeatureValues;
-    mutable std::vector<double> _tempLeftY;
-    mutable std::vector<double> _tempRightY;
+    // Exact-mode training buffers, released once the tree is built
+    size_t _sampleCount;
+    std::vector<int> _sortedSamples;  // per feature, a segment of _sampleCount row indices in feature order
+    std::vector<int> _scratch;
+    std::vector<char> _goesLeft;      // per-row split side, reused across nodes
+    
+    std::vector<double> _featureImportances;  // summed (node samples x variance decrease) per feature
 
 public:
     DecisionTree(int maxDepth = sdrs::constants::risk::RF_MAX_DEPTH, int minSamplesSplit = sdrs::constants::risk::RF_MIN_SAMPLES_SPLIT);
     ~DecisionTree();
 
-    void train(const std::vector<std::vector<double>>& X, const std::vector<double>& y);  // X=features, y=labels
+    // sampleCounts[i] = how many times row i appears in this tree's bootstrap sample
+    void train(const FeatureMatrix& matrix, const std::vector<double>& y, const std::vector<int>& sampleCounts);
+    void trainHistogram(const BinnedFeatures& binned, const std::vector<double>& y, std::vector<int> sampleIndices);  // rows may repeat
     double predict(const std::vector<double>& features) const;  // returns predicted value
     bool isTrained() const;
     int getDepth() const;
+    const std::vector<double>& getFeatureImportances() const;  // raw, not normalized
+
+    void flattenInto(FlatForest& forest) const;  // appends this tree's nodes and root offset
 
 private:
-    std::unique_ptr<TreeNode> buildTree(const std::vector<std::vector<double>>& X, const std::vector<double>& y, int depth);
+    // Node samples are positions [begin, end) of every feature segment in _sortedSamples
+    std::unique_ptr<TreeNode> buildTree(
+        const FeatureMatrix& matrix,
+        const std::vector<double>& y,
+        size_t begin,
+        size_t end,
+        int depth
+    );
     
+    // Exact split search: one pass per feature with running sums of y and y^2
     void findBestSplit(
-        const std::vector<std::vector<double>>& X,
+        const FeatureMatrix& matrix,
         const std::vector<double>& y,
+        size_t begin,
+        size_t end,
+        double parentVariance,
         int& bestFeature,
         double& bestThreshold,
         double& bestGain
     ) const;
-
-    double calculateVariance(const std::vector<double>& values) const;
     
-    double calculateMean(const std::vector<double>& values) const;
+    // Stable in-place partition of every feature segment, so children stay sorted; returns left size
+    size_t partitionSamples(
+        const FeatureMatrix& matrix,
+        size_t begin,
+        size_t end,
+        int featureIdx,
+        double threshold
+    );
+    
+    // Histogram mode: node samples are the range `samples`, partitioned in place;
+    // `histogram` is consumed (the larger child reuses it as parent minus sibling)
+    std::unique_ptr<TreeNode> buildHistogramTree(
+        const BinnedFeatures& binned,
+        const std::vector<double>& y,
+        std::span<int> samples,
+        std::vector<HistogramBin>& histogram,
+        int depth
+    );
     
-    void splitData(
-        const std::vector<std::vector<double>>& X,
+    void buildHistogram(
+        const BinnedFeatures& binned,
         const std::vector<double>& y,
-        int featureIdx,
-        double threshold,
-        std::vector<std::vector<double>>& leftX,
-        std::vector<double>& leftY,
-        std::vector<std::vector<double>>& rightX,
-        std::vector<double>& rightY
+        std::span<const int> samples,
+        std::vector<HistogramBin>& histogram
+    ) const;
+    
+    void findBestHistogramSplit(
+        const BinnedFeatures& binned,
+        const std::vector<HistogramBin>& histogram,
+        double parentVariance,
+        int& bestFeature,
+        int& bestBin,
+        double& bestGain
     ) const;
     
     double predictRecursive(const TreeNode* node, const std::vector<double>& features) const;
+    int flattenNode(const TreeNode* node, FlatForest& forest) const;
 };
 
 // Ensemble of decision trees - averages predictions for better accuracy
+class MappedFile;
+
 class RandomForest
 {
 private:
     std::vector<std::unique_ptr<DecisionTree>> _trees;
+    std::map<int, double> _featureImportances;     // impurity-based, sums to 1; saved with the model
+    FlatForest _flatForest;                        // compiled from _trees after training
+    std::shared_ptr<const MappedFile> _modelFile;  // backing storage when loaded from disk
+    FlatForestView _forestView;                    // what predict() walks: _flatForest or _modelFile
     
     int _numTrees;
     int _maxDepth;
     int _minSamplesSplit;
+    int _numFeatures;
+    SplitMode _splitMode;
     bool _isTrained;
     
-    std::mt19937 _randomEngine;
+    uint32_t _seed;     // tree i draws from seed_seq{_seed, i}, independent of thread count
+    int _numThreads;    // 0 = std::thread::hardware_concurrency()
 
 public:
     RandomForest(
         int numTrees = sdrs::constants::risk::RF_NUM_TREES,
         int maxDepth = sdrs::constants::risk::RF_MAX_DEPTH,
-        int minSamples = sdrs::constants::risk::RF_MIN_SAMPLES_SPLIT
+        int minSamples = sdrs::constants::risk::RF_MIN_SAMPLES_SPLIT,
+        SplitMode splitMode = SplitMode::Exact
     );
     ~RandomForest();
     
     void train(const std::vector<std::vector<double>>& X, const std::vector<double>& y);  // trains all trees with bootstrap sampling
     double predict(const std::vector<double>& features) const;  // returns average of all tree predictions
+    double predict(const double* features) const;               // features holds getNumFeatures() values
+    std::vector<double> predictBatch(const std::vector<double>& columns, size_t numRows) const;  // column-major feature matrix
     bool isTrained() const;
     int getNumTrees() const;
-    const std::map<int, double>& getFeatureImportances() const;  // which features matter most
+    SplitMode getSplitMode() const;
+    void setSeed(uint32_t seed);
+    void setNumThreads(int numThreads);
+    const std::map<int, double>& getFeatureImportances() const;  // which features matter most (impurity decrease)
+    
+    // Mean increase in squared error when one feature column of a held-out set is shuffled;
+    // features are scored in parallel. Column-major input like predictBatch().
+    std::map<int, double> computePermutationImportances(
+        const std::vector<double>& columns,
+        const std::vector<double>& y,
+        int numRepeats = sdrs::constants::risk::RF_PERMUTATION_REPEATS
+    ) const;
+    int getNumFeatures() const;
+    const FlatForestView& getForestView() const;
+    
+    void saveModel(const std::string& path) const;  // versioned binary artifact
+    void loadModel(const std::string& path);        // mmaps the artifact; no copy, no retraining
 
 private:
-    void bootstrapSample(
-        const std::vector<std::vector<double>>& X,
-        const std::vector<double>& y,
-        std::vector<std::vector<double>>& sampleX,
-        std::vector<double>& sampleY
-    );
+    void compile();  // packs all trained trees into _flatForest
+    void collectFeatureImportances();  // averages the per-tree shares into _featureImportances
+    
+    // Builds tree `treeIndex` with its own RNG stream; only the input matching the split mode is filled
+    std::unique_ptr<DecisionTree> trainTree(
+        int treeIndex,
+        size_t numSamples,
+        const FeatureMatrix& matrix,
+        const BinnedFeatures& binned,
+        const std::vector<double>& y
+    ) const;
+    
+    static void bootstrapCounts(size_t numSamples, std::vector<int>& counts, std::mt19937& randomEngine);
+    static void bootstrapIndices(size_t numSamples, std::vector<int>& indices, std::mt19937& randomEngine);
 };
 
 }
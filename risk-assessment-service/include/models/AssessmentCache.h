@@ -0,0 +1,110 @@
+// AssessmentCache.h - Sharded, preallocated LRU/TTL cache of risk scores keyed by input fingerprint and model version
+
+#ifndef SDRS_RISK_ASSESSMENT_CACHE_H
+#define SDRS_RISK_ASSESSMENT_CACHE_H
+
+#include "RiskScorer.h"
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace sdrs::risk
+{
+
+// Every RiskFeatures field the scorer reads, in canonical form, plus the model version the score came from.
+// Any changed input or a new model gives a different key, so stale entries are never hit.
+struct AssessmentKey
+{
+    static constexpr size_t NUM_WORDS = 13;
+
+    std::array<uint64_t, NUM_WORDS> words{};
+    uint64_t hash = 0;
+
+    static AssessmentKey make(const RiskFeatures& features, uint64_t modelVersion);  // modelVersion 0 = rule-based
+    bool operator==(const AssessmentKey& other) const;
+};
+
+// Scoring output only; the assessment around it (factors, dates) is rebuilt on every call
+struct CachedScore
+{
+    double riskScore = 0.0;
+    AlgorithmUsed algorithm = AlgorithmUsed::RuleBase;
+};
+
+struct AssessmentCacheStats
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;    // pushed out by capacity
+    uint64_t expirations = 0;  // found past their TTL
+    size_t entries = 0;
+    size_t capacity = 0;
+};
+
+class AssessmentCache
+{
+private:
+    static constexpr uint32_t NO_ENTRY = UINT32_MAX;
+
+    // Unused entries are chained through `older` as the shard's free list
+    struct Entry
+    {
+        AssessmentKey key;
+        CachedScore score;
+        std::chrono::steady_clock::time_point expiresAt;
+        uint32_t newer = NO_ENTRY;
+        uint32_t older = NO_ENTRY;
+    };
+
+    // One lock per shard. Entries and index are sized once in the constructor, so lookups,
+    // inserts and evictions never allocate; entries form an LRU list from newest to oldest.
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::vector<Entry> entries;
+        std::vector<uint32_t> slots;  // open addressing, linear probing; NO_ENTRY = empty
+        uint32_t newest = NO_ENTRY;
+        uint32_t oldest = NO_ENTRY;
+        uint32_t freeList = NO_ENTRY;
+        size_t size = 0;
+
+        void reset();
+        size_t findSlot(const AssessmentKey& key) const;  // slots.size() when absent
+        void insertSlot(uint32_t entry);
+        void eraseSlot(size_t slot);
+        void unlink(uint32_t entry);
+        void pushNewest(uint32_t entry);
+        void remove(size_t slot);  // drops the entry in this slot and frees it
+    };
+
+    std::vector<Shard> _shards;
+    size_t _shardCapacity;
+    std::chrono::seconds _ttl;
+
+    std::atomic<uint64_t> _hits;
+    std::atomic<uint64_t> _misses;
+    std::atomic<uint64_t> _evictions;
+    std::atomic<uint64_t> _expirations;
+
+public:
+    AssessmentCache(
+        size_t capacity = sdrs::constants::risk::RISK_CACHE_CAPACITY,
+        std::chrono::seconds ttl = std::chrono::seconds(sdrs::constants::risk::RISK_CACHE_TTL_SECONDS),
+        size_t numShards = sdrs::constants::risk::RISK_CACHE_SHARDS);
+
+    std::optional<CachedScore> find(const AssessmentKey& key);
+    void insert(const AssessmentKey& key, const CachedScore& score);
+    void clear();  // drops every entry; counters are kept
+
+    bool isEnabled() const;  // false when built with capacity 0
+    AssessmentCacheStats getStats() const;
+    std::chrono::seconds getTtl() const;
+
+private:
+    Shard& shardFor(const AssessmentKey& key);
+};
+
+}
+
+#endif
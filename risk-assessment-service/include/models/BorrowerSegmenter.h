@@ -0,0 +1,52 @@
+// BorrowerSegmenter.h - Mini-batch K-Means over the whole portfolio, streamed page by page from the database
+
+#ifndef SDRS_RISK_BORROWER_SEGMENTER_H
+#define SDRS_RISK_BORROWER_SEGMENTER_H
+
+#include "../algorithms/KMeansClustering.h"
+#include "../repositories/BorrowerSegmentRepository.h"
+#include <functional>
+
+namespace sdrs::risk
+{
+
+struct SegmentationSummary
+{
+    int numClusters = 0;
+    int passes = 0;
+    size_t accountsSegmented = 0;
+    double inertia = 0.0;                         // in scaled feature units
+    std::vector<std::vector<double>> centroids;   // in raw feature units
+    std::vector<size_t> clusterSizes;
+};
+
+// Only one page of accounts is held in memory at a time: `passes` scans feed partialFit(),
+// a final scan labels every account and writes borrower_segments page by page.
+class BorrowerSegmenter
+{
+private:
+    BorrowerSegmentRepository& _repository;
+    int _pageSize;
+
+    // Features are divided by these before clustering so income does not dominate the distance
+    static constexpr std::array<double, SEGMENT_NUM_FEATURES> FEATURE_SCALES = {
+        100.0,         // age (years)
+        50000000.0,    // monthly_income (VND)
+        1.0,           // debt_ratio
+        365.0,         // days_past_due
+        12.0           // missed_payments
+    };
+
+public:
+    explicit BorrowerSegmenter(BorrowerSegmentRepository& repository, int pageSize = sdrs::constants::risk::KMEANS_STREAM_PAGE_SIZE);
+
+    SegmentationSummary run(int numClusters, int passes = sdrs::constants::risk::KMEANS_MINI_BATCH_PASSES);
+
+private:
+    // Calls onPage(rows, scaledRows) for every page; both buffers are reused across pages
+    size_t scanPages(const std::function<void(const std::vector<SegmentFeatureRow>&, const std::vector<std::vector<double>>&)>& onPage);
+};
+
+}
+
+#endif
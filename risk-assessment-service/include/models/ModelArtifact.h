@@ -0,0 +1,129 @@
+// ModelArtifact.h - Versioned binary model files, loaded through a read-only memory mapping
+
+#ifndef SDRS_RISK_MODEL_ARTIFACT_H
+#define SDRS_RISK_MODEL_ARTIFACT_H
+
+#include "../../../common/include/utils/Constants.h"
+#include "../../../common/include/exceptions/ValidationException.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace sdrs::risk
+{
+
+enum class ModelType : uint32_t
+{
+    RandomForest = 1,
+    KMeans = 2
+};
+
+// Fixed header at offset 0 of every model file; sections follow, each 8-byte aligned
+struct ModelFileHeader
+{
+    char magic[8];           // MODEL_FILE_MAGIC, NUL padded
+    uint32_t formatVersion;  // MODEL_FORMAT_VERSION at write time
+    uint32_t modelType;      // ModelType
+    uint64_t fileSize;       // detects truncated files
+};
+
+// Read-only mmap of a whole file. Pages are shared with every other process mapping the same file.
+class MappedFile
+{
+private:
+    const std::byte* _data;
+    size_t _size;
+
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    // Non-copyable
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const std::byte* data() const;
+    size_t size() const;
+};
+
+// Builds a model file in memory, then publishes it with write-to-temp + rename
+class ModelWriter
+{
+private:
+    std::vector<std::byte> _buffer;
+
+public:
+    explicit ModelWriter(ModelType type);
+
+    template<typename T>
+    void writeValue(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        append(&value, sizeof(T));
+    }
+
+    // Count prefix, then the elements starting on an 8-byte boundary
+    template<typename T>
+    void writeArray(std::span<const T> values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        writeValue<uint64_t>(values.size());
+        append(values.data(), values.size_bytes());
+    }
+
+    void saveToFile(const std::string& path);
+
+private:
+    void append(const void* data, size_t size);  // pads the buffer to 8 bytes afterwards
+};
+
+// Walks the sections of a mapped model file. Arrays are views into the mapping, not copies,
+// so they stay valid for as long as getFile() is kept alive.
+class ModelReader
+{
+private:
+    std::shared_ptr<const MappedFile> _file;
+    size_t _offset;
+
+public:
+    ModelReader(std::shared_ptr<const MappedFile> file, ModelType expectedType);
+
+    template<typename T>
+    T readValue()
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    std::span<const T> readArray()
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        uint64_t count = readValue<uint64_t>();
+        if (count > _file->size() / sizeof(T))
+        {
+            throw sdrs::exceptions::ValidationException(
+                "Model file array length out of range", "modelPath",
+                sdrs::constants::ValidationErrorCode::InvalidFormat
+            );
+        }
+        const std::byte* data = take(count * sizeof(T));
+        return std::span<const T>(reinterpret_cast<const T*>(data), count);
+    }
+
+    const std::shared_ptr<const MappedFile>& getFile() const;
+
+private:
+    const std::byte* take(size_t size);  // bounds-checked, advances to the next 8-byte boundary
+};
+
+}
+
+#endif
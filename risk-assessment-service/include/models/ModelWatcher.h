@@ -0,0 +1,63 @@
+// ModelWatcher.h - Background reload of the active risk model when its artifact changes
+
+#ifndef SDRS_RISK_MODEL_WATCHER_H
+#define SDRS_RISK_MODEL_WATCHER_H
+
+#include "RiskScorer.h"
+#include <string>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <filesystem>
+
+namespace sdrs::risk
+{
+
+// Polls the artifact path (re-resolved each time, e.g. from the model registry) and hot-swaps
+// a new or rewritten file into the scorer. Scoring threads are never blocked by a reload.
+class ModelWatcher
+{
+private:
+    RiskScorer& _scorer;
+    std::function<std::string()> _resolvePath;
+    std::chrono::seconds _interval;
+
+    std::thread _thread;
+    std::mutex _stateMutex;       // guards _stopping
+    std::condition_variable _wakeup;
+    bool _stopping;
+
+    std::mutex _reloadMutex;      // one reload at a time; guards the watched-file state below
+    std::string _watchedPath;
+    std::filesystem::file_time_type _watchedWriteTime;
+
+public:
+    ModelWatcher(RiskScorer& scorer, std::function<std::string()> resolvePath, std::chrono::seconds interval);
+    ~ModelWatcher();
+
+    // Non-copyable
+    ModelWatcher(const ModelWatcher&) = delete;
+    ModelWatcher& operator=(const ModelWatcher&) = delete;
+
+    void start();
+    void stop();
+
+    // Loads the resolved artifact now, even if unchanged; returns the published version
+    uint64_t reload();
+
+    // Reloads only if the resolved path or its modification time changed; true if a new model was published
+    bool pollOnce();
+
+    // Records the artifact the scorer already serves, so the first poll does not reload it
+    void markLoaded(const std::string& modelPath);
+
+private:
+    void run();
+    uint64_t reloadLocked(const std::string& modelPath);
+};
+
+}
+
+#endif
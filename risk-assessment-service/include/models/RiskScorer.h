@@ -8,6 +8,12 @@
 #include <vector>
 #include <memory>
 #include <chrono>
+#include <span>
+#include <atomic>
+#include <cstdint>
+#include <array>
+#include <optional>
+#include <string_view>
 
 #include "../../../common/include/models/Money.h"
 #include "../../../common/include/utils/Constants.h"
@@ -18,6 +24,9 @@ namespace sdrs::risk
 {
 
 class RandomForest;
+class CompactForest;
+class AssessmentCache;
+enum class ModelPrecision;  // CompactForest.h
 
 enum class AlgorithmUsed
 {
@@ -25,6 +34,24 @@ enum class AlgorithmUsed
     RuleBase
 };
 
+// Interned risk factor names: assessments store contributions by index, not by string key.
+// Alphabetical, so serialized output keeps the key order of a sorted map.
+enum class RiskFactor : uint8_t
+{
+    AccountStatus,
+    DaysPastDue,
+    DebtRatio,
+    Employment,
+    MissedPayments
+};
+
+inline constexpr size_t NUM_RISK_FACTORS = 5;
+inline constexpr std::array<std::string_view, NUM_RISK_FACTORS> RISK_FACTOR_NAMES = {
+    "account_status", "days_past_due", "debt_ratio", "employment", "missed_payments"
+};
+
+using RiskFactorValues = std::array<double, NUM_RISK_FACTORS>;  // indexed by RiskFactor
+
 class RiskAssessment
 {
 private:
@@ -34,7 +61,8 @@ private:
     double _riskScore;
     sdrs::constants::RiskLevel _riskLevel;
     AlgorithmUsed _algorithmUsed;
-    std::map<std::string, double> _riskFactors;
+    RiskFactorValues _riskFactors;
+    uint32_t _riskFactorMask;  // bit i set = factor i has a value
     std::chrono::sys_seconds _assessmentDate;
     std::chrono::sys_seconds _createdAt;
 
@@ -52,16 +80,19 @@ public:
     std::chrono::sys_seconds getAssessmentDate() const;
     std::chrono::sys_seconds getCreatedAt() const;
 
-    const std::map<std::string, double>& getRiskFactors() const;  // breakdown of risk contributors
-    void addRiskFactor(const std::string& factorName, double contribution);
+    std::map<std::string, double> getRiskFactors() const;  // breakdown of risk contributors, built on demand
+    std::optional<double> getRiskFactor(RiskFactor factor) const;
+    void setRiskFactor(RiskFactor factor, double contribution);  // no allocation
+    void addRiskFactor(const std::string& factorName, double contribution);  // names outside RISK_FACTOR_NAMES are logged and dropped
 
     std::string toJson() const;
     static std::string riskLevelToString(sdrs::constants::RiskLevel level);
     static sdrs::constants::RiskLevel stringToRiskLevel(const std::string& levelStr);
+    static std::string_view riskFactorToString(RiskFactor factor);
+    static std::optional<RiskFactor> stringToRiskFactor(std::string_view name);
 
 private:
     sdrs::constants::RiskLevel determineRiskLevel(double score) const;
-    void touch();
 
 };
 
@@ -77,29 +108,79 @@ struct RiskFeatures
     int daysPastDue = 0;
     int numberOfMissedPayments = 0;
     int loanTermMonths = 0;
-    sdrs::constants::AccountStatus accountStatus;
+    sdrs::constants::AccountStatus accountStatus{};
 
     // Borrower data
     int age = 0;  // Age of borrower (key feature for risk assessment)
     sdrs::money::Money monthlyIncome;
-    sdrs::constants::EmploymentStatus employmentStatus;  // Enum: Employed, Unemployed, SelfEmployed, etc.
+    sdrs::constants::EmploymentStatus employmentStatus{};  // Enum: Employed, Unemployed, SelfEmployed, etc.
 
     // Calculated metrics
-    int accountAgeMonths;
-    double debtToIncomeRatio;
+    int accountAgeMonths = 0;
+    double debtToIncomeRatio = 0.0;
 
     RiskFeatures();
     void validate() const;
 };
 
+// Immutable once published; a reader holds one for the duration of a call
+struct ScoringModel
+{
+    std::shared_ptr<const RandomForest> forest;
+    std::shared_ptr<const CompactForest> compact;  // scores instead of the forest when set
+    uint64_t version = 0;  // increases on every publish
+    std::string source;    // artifact path, or "synthetic" when trained in-process
+};
+
+// Per-feature importances of the current model, keyed by feature name
+struct FeatureImportanceReport
+{
+    uint64_t modelVersion = 0;
+    size_t holdoutRows = 0;
+    std::map<std::string, double> impurity;     // share of training variance reduction, sums to 1
+    std::map<std::string, double> permutation;  // held-out MSE increase when the feature is shuffled
+};
+
+// A reduced-precision copy of the current model against the double-precision forest, on held-out rows
+struct PrecisionReport
+{
+    uint64_t modelVersion = 0;
+    ModelPrecision precision{};
+    size_t holdoutRows = 0;
+    size_t nodeCount = 0;
+    size_t memoryBytes = 0;           // inference structures at this precision
+    size_t referenceMemoryBytes = 0;  // the same for the double-precision forest
+    double maxAbsDelta = 0.0;         // largest |score - reference score|
+    double meanAbsDelta = 0.0;
+    double mse = 0.0;                 // against the held-out labels
+    double referenceMse = 0.0;
+    double riskLevelAgreement = 1.0;  // share of rows given the same risk level as the reference
+};
+
 // Assess loan risk using ML (RandomForest) or Rule-Based algorithm
 // OOP: Encapsulation + Composition (contains RandomForest) + Strategy Pattern (ML vs Rule)
 class RiskScorer
 {
 private:
-    std::shared_ptr<RandomForest> _randomForest;
-    bool _useMLModel;
-    bool _isModelTrained;
+    // Swapped as a whole on train/load; readers take a snapshot and never lock
+    std::atomic<std::shared_ptr<const ScoringModel>> _model;
+    std::atomic<bool> _useMLModel;
+    std::atomic<uint64_t> _lastModelVersion;
+    std::atomic<ModelPrecision> _precision;  // applied to every model published from now on
+    std::unique_ptr<AssessmentCache> _cache;  // assessRisk() scores by input fingerprint + model version
+
+    static constexpr size_t NUM_FEATURES = 9;
+    static constexpr std::array<const char*, NUM_FEATURES> FEATURE_NAMES = {
+        "days_past_due", "missed_payments", "debt_ratio", "interest_rate", "monthly_income",
+        "account_age_months", "age", "employment_status", "account_status"
+    };
+
+    // One model input row, in FEATURE_NAMES order; lives on the stack
+    using FeatureRecord = std::array<double, NUM_FEATURES>;
+    
+    static constexpr int TRAINING_SEED = 42;
+    static constexpr int HOLDOUT_SEED = 4242;          // disjoint stream from the training data
+    static constexpr int IMPORTANCE_HOLDOUT_SAMPLES = 2000;
 
     // Feature normalization constants
     static constexpr double MAX_DAYS_PAST_DUE = 365.0;
@@ -111,38 +192,70 @@ private:
     static constexpr double MAX_EMPLOYMENT_RISK_SCORE = 1.0;
     static constexpr double MAX_ACCOUNT_STATUS_RISK_SCORE = 1.0;
 
+    // Divisors used by normalizeFeatures(), in FEATURE_NAMES order
+    static constexpr FeatureRecord FEATURE_MAX_VALUES = {
+        MAX_DAYS_PAST_DUE,
+        MAX_MISSED_PAYMENTS,
+        MAX_REMAINING_BALANCE_RATIO,
+        MAX_INTEREST_RATE,
+        MAX_MONTHLY_INCOME,
+        MAX_LOAN_TERM,              // account_age_months (in months, so MAX_LOAN_TERM=120 is appropriate)
+        100.0,                      // age (max 100 years)
+        MAX_EMPLOYMENT_RISK_SCORE,
+        MAX_ACCOUNT_STATUS_RISK_SCORE
+    };
+
 public:
-    RiskScorer();
+    explicit RiskScorer(
+        size_t cacheCapacity = sdrs::constants::risk::RISK_CACHE_CAPACITY,  // 0 disables the cache
+        std::chrono::seconds cacheTtl = std::chrono::seconds(sdrs::constants::risk::RISK_CACHE_TTL_SECONDS));
     ~RiskScorer();
 
-    // Main API: assess risk and return full assessment result
+    // Main API: assess risk and return full assessment result. Repeat calls with identical inputs
+    // under the same model reuse the cached score; the assessment itself is stamped afresh.
     RiskAssessment assessRisk(const RiskFeatures& features);
 
+    // Scores many accounts at once; the ML path evaluates the forest over a column-major feature matrix
+    std::vector<RiskAssessment> assessRiskBatch(std::span<const RiskFeatures> features);
+
     void trainModel();   // trains RandomForest on synthetic data
-    void loadModel(const std::string& modelPath);  // TODO: load from file
+    uint64_t loadModel(const std::string& modelPath);    // reloadModel() + switch scoring to the ML model
+    uint64_t reloadModel(const std::string& modelPath);  // maps a saved artifact and hot-swaps it in; returns its version
+    void saveModel(const std::string& modelPath) const;
     bool isModelReady() const;
+    std::shared_ptr<const ScoringModel> getModel() const;  // current snapshot, nullptr before the first train/load
+    uint64_t getActiveModelVersion() const;  // version assessRisk() scores with; 0 while rule-based
+    FeatureImportanceReport computeFeatureImportances() const;  // throws if no model is loaded
+    PrecisionReport evaluatePrecision(ModelPrecision precision) const;  // throws if no model is loaded
+
+    // Scores with a Float32 / Quantized16 copy of every model from now on (Float64 = the forest itself).
+    // The current model is republished under a new version; returns it, or 0 when none is loaded yet.
+    uint64_t setModelPrecision(ModelPrecision precision);
+    ModelPrecision getModelPrecision() const;
     void setUseMLModel(bool useML);  // if false, uses rule-based scoring
+    const AssessmentCache& getCache() const;
 
 private:
-    std::vector<double> extractFeatures(const RiskFeatures& input) const;
-    std::vector<double> normalizeFeatures(const std::vector<double>& raw) const;
+    FeatureRecord extractFeatures(const RiskFeatures& input) const;
+    FeatureRecord normalizeFeatures(const FeatureRecord& raw) const;
 
-    double predictWithML(const std::vector<double>& features) const;
-    double calculateRuleBasedScore(const RiskFeatures& features) const;
+    uint64_t publishModel(std::shared_ptr<const RandomForest> forest, const std::string& source);
+    std::shared_ptr<const ScoringModel> activeModel() const;  // snapshot when ML scoring is on, else nullptr
 
-    std::map<std::string, double> calculateFeatureContributions(const RiskFeatures& features, double finalScore) const;
-    
-    static double encodeEmploymentStatus(sdrs::constants::EmploymentStatus status);
-    static double getEmploymentRiskContribution(sdrs::constants::EmploymentStatus status);
+    double predictWithML(const ScoringModel& model, const FeatureRecord& features) const;
+    std::vector<double> predictBatchWithML(const ScoringModel& model, std::span<const RiskFeatures> features) const;
+    void buildHoldoutColumns(std::vector<double>& columns, std::vector<double>& y) const;  // column-major, HOLDOUT_SEED rows
+    double calculateRuleBasedScore(const RiskFeatures& features) const;
 
-    static double encodeAccountStatus(sdrs::constants::AccountStatus status);
-    static double getAccountRiskContribution(sdrs::constants::AccountStatus status);
+    RiskFactorValues calculateFeatureContributions(const RiskFeatures& features, double finalScore) const;
+    RiskAssessment buildAssessment(const RiskFeatures& features, double riskScore, AlgorithmUsed algorithm) const;
     
     // Generate synthetic training data for ML model
     void generateSyntheticData(
-        std::vector<std::vector<double>>& X,
+        std::vector<FeatureRecord>& X,
         std::vector<double>& y,
-        int numSamples
+        int numSamples,
+        int seed = TRAINING_SEED
     ) const;
 };
 
@@ -0,0 +1,177 @@
+// RuleBasedScorer.h - Rule-based risk score; every rule is constexpr data, lookup tables are built at compile time
+
+#ifndef SDRS_RISK_RULE_BASED_SCORER_H
+#define SDRS_RISK_RULE_BASED_SCORER_H
+
+#include "RiskScorer.h"
+#include <algorithm>
+#include <array>
+#include <span>
+#include <utility>
+
+namespace sdrs::risk
+{
+
+namespace rules
+{
+
+// Score added once a value reaches (DPD) or exceeds (DTI) the threshold; tiers ascend
+struct ScoreTier
+{
+    double threshold;
+    double score;
+};
+
+// Score added for ages/months in [minValue, maxValue]
+struct ScoreBand
+{
+    int minValue;
+    int maxValue;
+    double score;
+};
+
+// Below the first tier the old scorer added daysPastDue / DPD_DEFAULT_THRESHOLD * 0.20 in integer
+// division, which is 0 for every non-negative count; the table keeps that behaviour
+inline constexpr std::array<ScoreTier, 3> DPD_TIERS = {{
+    {sdrs::constants::risk::DPD_LOW_THRESHOLD, 0.20},
+    {sdrs::constants::risk::DPD_MEDIUM_THRESHOLD, 0.30},
+    {sdrs::constants::risk::DPD_HIGH_THRESHOLD, 0.40}
+}};
+
+inline constexpr double MISSED_PAYMENT_WEIGHT = 0.10;
+inline constexpr double MISSED_PAYMENT_CAP = 0.30;
+inline constexpr double DEBT_RATIO_WEIGHT = 0.20;
+
+// Monthly payment (remaining * (1 + interest) / 12) over monthly income
+inline constexpr std::array<ScoreTier, 4> DTI_TIERS = {{
+    {0.10, 0.05},   // 10-20% of income (manageable)
+    {0.20, 0.10},   // 20-35% (borderline)
+    {0.35, 0.15},   // 35-50%
+    {0.50, 0.25}    // over 50%
+}};
+inline constexpr double NO_INCOME_WITH_DEBT_SCORE = 0.35;  // cannot repay at all
+
+inline constexpr int MAX_TABLE_AGE = 120;  // older ages share the last entry
+inline constexpr std::array<ScoreBand, 3> AGE_BANDS = {{
+    {1, 24, 0.10},              // young, less financial stability
+    {35, 50, -0.05},            // prime working age
+    {65, MAX_TABLE_AGE, 0.08}   // older, income concerns
+}};
+
+inline constexpr int MAX_TABLE_ACCOUNT_AGE = 6;  // 6+ months is established
+inline constexpr std::array<ScoreBand, 2> ACCOUNT_AGE_BANDS = {{
+    {1, 2, 0.10},   // very new account
+    {3, 5, 0.05}    // new account
+}};
+
+using sdrs::constants::EmploymentStatus;
+using sdrs::constants::AccountStatus;
+
+inline constexpr std::array<std::pair<EmploymentStatus, double>, 8> EMPLOYMENT_RISK_RULES = {{
+    {EmploymentStatus::Employed, 0.0}, {EmploymentStatus::Contract, 0.0}, {EmploymentStatus::SelfEmployed, 0.0},
+    {EmploymentStatus::PartTime, 0.05}, {EmploymentStatus::Student, 0.05},
+    {EmploymentStatus::Unemployed, 0.10}, {EmploymentStatus::Retired, 0.10}, {EmploymentStatus::None, 0.10}
+}};
+inline constexpr std::array<std::pair<EmploymentStatus, double>, 8> EMPLOYMENT_ENCODING_RULES = {{
+    {EmploymentStatus::Employed, 1.0}, {EmploymentStatus::Contract, 1.0}, {EmploymentStatus::SelfEmployed, 1.0},
+    {EmploymentStatus::PartTime, 0.5}, {EmploymentStatus::Student, 0.5},
+    {EmploymentStatus::Unemployed, 0.0}, {EmploymentStatus::Retired, 0.0}, {EmploymentStatus::None, 0.0}
+}};
+inline constexpr std::array<std::pair<AccountStatus, double>, 7> ACCOUNT_RISK_RULES = {{
+    {AccountStatus::PaidOff, 0.0}, {AccountStatus::Current, 0.0}, {AccountStatus::Partial, 0.02},
+    {AccountStatus::Settled, 0.04}, {AccountStatus::Delinquent, 0.06},
+    {AccountStatus::Default, 0.10}, {AccountStatus::ChargedOff, 0.10}
+}};
+inline constexpr std::array<std::pair<AccountStatus, double>, 7> ACCOUNT_ENCODING_RULES = {{
+    {AccountStatus::PaidOff, 1.0}, {AccountStatus::Current, 1.0}, {AccountStatus::Partial, 0.8},
+    {AccountStatus::Settled, 0.6}, {AccountStatus::Delinquent, 0.4},
+    {AccountStatus::Default, 0.0}, {AccountStatus::ChargedOff, 0.0}
+}};
+
+// Indexed by enum value; the extra last entry is the fallback for out-of-range values
+template<typename Enum, size_t N>
+constexpr std::array<double, N + 1> buildEnumTable(const std::array<std::pair<Enum, double>, N>& rules, double fallback)
+{
+    std::array<double, N + 1> table{};
+    table.fill(fallback);
+    for (const auto& [value, score] : rules)
+    {
+        table[static_cast<size_t>(value)] = score;
+    }
+    return table;
+}
+
+// Indexed by value in [0, MaxValue]; values outside every band score 0
+template<int MaxValue, size_t N>
+constexpr std::array<double, MaxValue + 1> buildBandTable(const std::array<ScoreBand, N>& bands)
+{
+    std::array<double, MaxValue + 1> table{};
+    for (const auto& band : bands)
+    {
+        for (int value = band.minValue; value <= band.maxValue; ++value)
+        {
+            table[value] = band.score;
+        }
+    }
+    return table;
+}
+
+// Tier values indexed by how many thresholds were passed; entry 0 (no tier reached) scores 0
+template<size_t N>
+constexpr std::array<double, N + 1> buildTierTable(const std::array<ScoreTier, N>& tiers)
+{
+    std::array<double, N + 1> table{};
+    for (size_t i = 0; i < N; ++i)
+    {
+        table[i + 1] = tiers[i].score;
+    }
+    return table;
+}
+
+inline constexpr auto EMPLOYMENT_RISK = buildEnumTable(EMPLOYMENT_RISK_RULES, 0.10);
+inline constexpr auto EMPLOYMENT_ENCODING = buildEnumTable(EMPLOYMENT_ENCODING_RULES, 0.0);
+inline constexpr auto ACCOUNT_RISK = buildEnumTable(ACCOUNT_RISK_RULES, 0.10);
+inline constexpr auto ACCOUNT_ENCODING = buildEnumTable(ACCOUNT_ENCODING_RULES, 0.5);
+inline constexpr auto AGE_RISK = buildBandTable<MAX_TABLE_AGE>(AGE_BANDS);
+inline constexpr auto ACCOUNT_AGE_RISK = buildBandTable<MAX_TABLE_ACCOUNT_AGE>(ACCOUNT_AGE_BANDS);
+inline constexpr auto DPD_RISK = buildTierTable(DPD_TIERS);
+inline constexpr auto DTI_RISK = buildTierTable(DTI_TIERS);
+
+static_assert(AGE_RISK[24] == 0.10 && AGE_RISK[25] == 0.0 && AGE_RISK[35] == -0.05 && AGE_RISK[65] == 0.08);
+static_assert(ACCOUNT_AGE_RISK[0] == 0.0 && ACCOUNT_AGE_RISK[2] == 0.10 && ACCOUNT_AGE_RISK[MAX_TABLE_ACCOUNT_AGE] == 0.0);
+static_assert(EMPLOYMENT_RISK[static_cast<size_t>(EmploymentStatus::Student)] == 0.05);
+static_assert(ACCOUNT_RISK[static_cast<size_t>(AccountStatus::Delinquent)] == 0.06);
+
+// Clamped table lookups; out-of-range enum values hit the fallback entry
+template<typename Enum, size_t N>
+constexpr double lookup(const std::array<double, N>& table, Enum value)
+{
+    return table[std::min(static_cast<size_t>(value), N - 1)];
+}
+
+template<size_t N>
+constexpr double lookup(const std::array<double, N>& table, int value)
+{
+    return table[std::clamp(value, 0, static_cast<int>(N) - 1)];
+}
+
+}
+
+// Stateless; RiskScorer delegates its rule-based path here
+class RuleBasedScorer
+{
+public:
+    static double score(const RiskFeatures& features);  // same result as the per-rule if/else chain it replaced
+
+    // Branch-free over every row: comparisons become 0/1 table indices and selects
+    static void scoreBatch(std::span<const RiskFeatures> features, std::span<double> scores);
+
+    static double employmentRisk(sdrs::constants::EmploymentStatus status);
+    static double accountRisk(sdrs::constants::AccountStatus status);
+    static double encodeEmployment(sdrs::constants::EmploymentStatus status);
+    static double encodeAccount(sdrs::constants::AccountStatus status);
+};
+
+}
+
+#endif
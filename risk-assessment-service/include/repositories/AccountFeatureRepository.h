@@ -0,0 +1,56 @@
+// AccountFeatureRepository.h - Scoring inputs per loan account (loan_accounts + borrowers) and their change feed
+
+#ifndef SDRS_RISK_ACCOUNT_FEATURE_REPOSITORY_H
+#define SDRS_RISK_ACCOUNT_FEATURE_REPOSITORY_H
+
+#include "../models/RiskScorer.h"
+#include "../../../common/include/database/DatabaseManager.h"
+#include <string>
+#include <vector>
+
+namespace sdrs::risk
+{
+
+// Change feed by polling: every row that feeds a score carries updated_at (kept by triggers), so
+// "changed since T" is a union over loan_accounts, payment_history and borrowers.
+class AccountFeatureRepository
+{
+private:
+    bool _useMock;
+
+public:
+    explicit AccountFeatureRepository(bool useMock = false);
+    ~AccountFeatureRepository() = default;
+
+    // Database clock to pass as `since` on the next change scan. Read it before scanning,
+    // so writes that land during the scan are picked up next time.
+    std::string currentWatermark();
+
+    // Keyset page over accounts of active borrowers with account_id > afterAccountId, in account_id order.
+    // Replaces the contents of `page`, so callers can reuse one buffer for the whole scan.
+    void findFeaturePage(int afterAccountId, int limit, std::vector<RiskFeatures>& page);
+
+    // Same, restricted to accounts whose loan, payments or borrower changed after
+    // (since - lookbackSeconds); the overlap catches transactions that committed late.
+    void findChangedPage(const std::string& since, int lookbackSeconds, int afterAccountId, int limit, std::vector<RiskFeatures>& page);
+
+private:
+    void mapRows(const pqxx::result& result, std::vector<RiskFeatures>& page);
+
+    // Mock implementations; the watermark is a change sequence number, and the seeded accounts never change after it
+    struct MockAccount
+    {
+        RiskFeatures features;
+        uint64_t changeSequence = 0;
+    };
+
+    static std::vector<MockAccount> makeMockAccounts();
+    void findPageMock(uint64_t sinceSequence, int afterAccountId, int limit, std::vector<RiskFeatures>& page);
+
+    static std::vector<MockAccount> _mockAccounts;
+    static uint64_t _mockSequence;
+};
+
+} // namespace sdrs::risk
+
+#endif // SDRS_RISK_ACCOUNT_FEATURE_REPOSITORY_H
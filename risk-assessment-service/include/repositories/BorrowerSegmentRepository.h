@@ -0,0 +1,59 @@
+// BorrowerSegmentRepository.h - Segmentation input (loan_accounts + borrowers) and output (borrower_segments)
+
+#ifndef SDRS_RISK_BORROWER_SEGMENT_REPOSITORY_H
+#define SDRS_RISK_BORROWER_SEGMENT_REPOSITORY_H
+
+#include "../../../common/include/database/DatabaseManager.h"
+#include <array>
+#include <string>
+#include <vector>
+
+namespace sdrs::risk
+{
+
+inline constexpr size_t SEGMENT_NUM_FEATURES = 5;
+
+// One loan account as seen by the segmentation job
+struct SegmentFeatureRow
+{
+    int accountId = 0;
+    int borrowerId = 0;
+    std::array<double, SEGMENT_NUM_FEATURES> values{};  // age, monthly_income, debt_ratio, days_past_due, missed_payments
+};
+
+struct BorrowerSegment
+{
+    int accountId = 0;
+    int borrowerId = 0;
+    int clusterId = 0;
+    double clusterDistance = 0.0;
+};
+
+class BorrowerSegmentRepository
+{
+private:
+    bool _useMock;
+
+public:
+    explicit BorrowerSegmentRepository(bool useMock = false);
+    ~BorrowerSegmentRepository() = default;
+
+    // Keyset page: accounts of active borrowers with account_id > afterAccountId, in account_id order.
+    // Replaces the contents of `page`, so callers can reuse one buffer for the whole scan.
+    void findFeaturePage(int afterAccountId, int limit, std::vector<SegmentFeatureRow>& page);
+
+    // Replaces the segment rows of these accounts in one transaction
+    void saveSegments(const std::vector<BorrowerSegment>& segments, const std::string& algorithm);
+
+private:
+    // Mock implementations
+    void findFeaturePageMock(int afterAccountId, int limit, std::vector<SegmentFeatureRow>& page);
+    void saveSegmentsMock(const std::vector<BorrowerSegment>& segments);
+
+    static std::vector<SegmentFeatureRow> _mockFeatures;
+    static std::vector<BorrowerSegment> _mockSegments;
+};
+
+} // namespace sdrs::risk
+
+#endif // SDRS_RISK_BORROWER_SEGMENT_REPOSITORY_H
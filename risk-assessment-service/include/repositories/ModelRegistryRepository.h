@@ -0,0 +1,52 @@
+// ModelRegistryRepository.h - Tracks model artifacts and the active version per type (ml_models table)
+
+#ifndef SDRS_RISK_MODEL_REGISTRY_REPOSITORY_H
+#define SDRS_RISK_MODEL_REGISTRY_REPOSITORY_H
+
+#include "../../../common/include/database/DatabaseManager.h"
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace sdrs::risk
+{
+
+struct ModelRecord
+{
+    int modelId = 0;
+    std::string modelName;
+    std::string modelType;     // "RandomForest" or "KMeans"
+    std::string version;
+    std::string artifactPath;  // binary model file written by saveModel()
+    int formatVersion = 0;
+    bool isActive = false;
+};
+
+class ModelRegistryRepository
+{
+private:
+    bool _useMock;
+
+public:
+    explicit ModelRegistryRepository(bool useMock = false);
+    ~ModelRegistryRepository() = default;
+
+    std::optional<ModelRecord> findActive(const std::string& modelType);
+
+    // Inserts the record as the active model of its type, deactivating the previous one
+    ModelRecord registerActive(const ModelRecord& record, const std::string& hyperparametersJson = "{}");
+
+private:
+    // Mock implementations
+    std::optional<ModelRecord> findActiveMock(const std::string& modelType);
+    ModelRecord registerActiveMock(const ModelRecord& record);
+
+    // Helper
+    static ModelRecord mapRowToModelRecord(const pqxx::row& row);
+    static int _nextMockId;
+    static std::vector<ModelRecord> _mockStorage;
+};
+
+} // namespace sdrs::risk
+
+#endif // SDRS_RISK_MODEL_REGISTRY_REPOSITORY_H
@@ -4,6 +4,7 @@
 #include "../../../common/include/database/DatabaseManager.h"
 #include <vector>
 #include <memory>
+#include <span>
 
 namespace sdrs::risk
 {
@@ -19,9 +20,13 @@ public:
 
     // CRUD operations
     RiskAssessment create(const RiskAssessment& assessment);
+    // One COPY in one transaction; if the database refuses any row, the batch is written again row by
+    // row and only the refused rows are skipped. Returns rows written; refused indices go to rejected.
+    size_t createBatch(std::span<const RiskAssessment> assessments, std::vector<size_t>* rejected = nullptr);
     RiskAssessment getById(int assessmentId);
     std::vector<RiskAssessment> getByAccountId(int accountId);
     std::vector<RiskAssessment> getByBorrowerId(int borrowerId);
+    std::vector<RiskAssessment> getLatestByAccountIds(std::span<const int> accountIds);  // accounts never assessed are absent
     std::vector<RiskAssessment> getAll();
     
     // Query by criteria
@@ -34,12 +39,16 @@ public:
 private:
     // Mock mode implementations
     RiskAssessment createMock(const RiskAssessment& assessment);
+    size_t createBatchMock(std::span<const RiskAssessment> assessments);
     RiskAssessment getByIdMock(int assessmentId);
     std::vector<RiskAssessment> getAllMock();
     std::vector<RiskAssessment> getByAccountIdMock(int accountId);
     std::vector<RiskAssessment> getByBorrowerIdMock(int borrowerId);
+    std::vector<RiskAssessment> getLatestByAccountIdsMock(std::span<const int> accountIds);
     
     // Helper methods
+    void copyBatch(std::span<const RiskAssessment> assessments);
+    size_t insertEach(std::span<const RiskAssessment> assessments, std::vector<size_t>* rejected);
     RiskAssessment mapRowToRiskAssessment(const pqxx::row& row);
     static int _nextMockId;
     static std::vector<RiskAssessment> _mockStorage;
@@ -0,0 +1,100 @@
+// DistanceKernels.cpp - Implementation
+
+#include "../../include/algorithms/DistanceKernels.h"
+#include <algorithm>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SDRS_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace sdrs::risk
+{
+
+namespace
+{
+
+// Plain loops; the compiler vectorizes the inner one for the baseline instruction set
+void squaredDistancesPortable(const double* point, size_t numFeatures, const double* centroids, size_t stride, double* out)
+{
+    std::fill(out, out + stride, 0.0);
+    for (size_t f = 0; f < numFeatures; ++f)
+    {
+        double value = point[f];
+        const double* row = centroids + f * stride;
+        for (size_t c = 0; c < stride; ++c)
+        {
+            double diff = value - row[c];
+            out[c] += diff * diff;
+        }
+    }
+}
+
+#ifdef SDRS_X86_KERNELS
+
+__attribute__((target("avx2,fma")))
+void squaredDistancesAvx2(const double* point, size_t numFeatures, const double* centroids, size_t stride, double* out)
+{
+    for (size_t c = 0; c < stride; c += 4)
+    {
+        __m256d sum = _mm256_setzero_pd();
+        for (size_t f = 0; f < numFeatures; ++f)
+        {
+            __m256d diff = _mm256_sub_pd(_mm256_set1_pd(point[f]), _mm256_loadu_pd(centroids + f * stride + c));
+            sum = _mm256_fmadd_pd(diff, diff, sum);
+        }
+        _mm256_storeu_pd(out + c, sum);
+    }
+}
+
+__attribute__((target("avx512f")))
+void squaredDistancesAvx512(const double* point, size_t numFeatures, const double* centroids, size_t stride, double* out)
+{
+    for (size_t c = 0; c < stride; c += 8)
+    {
+        __m512d sum = _mm512_setzero_pd();
+        for (size_t f = 0; f < numFeatures; ++f)
+        {
+            __m512d diff = _mm512_sub_pd(_mm512_set1_pd(point[f]), _mm512_loadu_pd(centroids + f * stride + c));
+            sum = _mm512_fmadd_pd(diff, diff, sum);
+        }
+        _mm512_storeu_pd(out + c, sum);
+    }
+}
+
+#endif
+
+std::vector<DistanceKernel> detectKernels()
+{
+    std::vector<DistanceKernel> kernels;
+
+#ifdef SDRS_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        kernels.push_back({"avx512", squaredDistancesAvx512});
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+        kernels.push_back({"avx2", squaredDistancesAvx2});
+    }
+#endif
+
+    kernels.push_back({"portable", squaredDistancesPortable});
+    return kernels;
+}
+
+}
+
+const std::vector<DistanceKernel>& getSupportedDistanceKernels()
+{
+    static const std::vector<DistanceKernel> kernels = detectKernels();
+    return kernels;
+}
+
+const DistanceKernel& getDistanceKernel()
+{
+    return getSupportedDistanceKernels().front();
+}
+
+}
@@ -1,10 +1,15 @@
 // KMeansClustering.cpp - Implementation
 
 #include "../../include/algorithms/KMeansClustering.h"
+#include "../../include/algorithms/DistanceKernels.h"
+#include "../../include/algorithms/ParallelTasks.h"
+#include "../../include/models/ModelArtifact.h"
 #include "../../../common/include/exceptions/ValidationException.h"
 #include <numeric>
 #include <cmath>
 #include <algorithm>
+#include <limits>
+#include <thread>
 
 using namespace sdrs::constants::risk;
 using namespace sdrs::exceptions;
@@ -12,11 +17,40 @@ using namespace sdrs::exceptions;
 namespace sdrs::risk
 {
 
+namespace
+{
+
+// Lends a pool to forEachRange() for one train() or partialFit() call and takes it back on return or throw
+class WorkerLease
+{
+private:
+    WorkerPool*& _slot;
+
+public:
+    WorkerLease(WorkerPool*& slot, WorkerPool& pool)
+        : _slot(slot)
+    {
+        _slot = &pool;
+    }
+
+    ~WorkerLease()
+    {
+        _slot = nullptr;
+    }
+};
+
+}
+
 KMeansClustering::KMeansClustering(int k, int maxIterations)
     : _k(k),
     _maxIterations(maxIterations),
+    _iterations(0),
+    _numThreads(0),
     _isTrained(false),
-    _randomEngine(std::random_device{}())
+    _inertia(0.0),
+    _centroidStride(0),
+    _randomEngine(std::random_device{}()),
+    _workers(nullptr)
 {
     if (k <= 0)
     {
@@ -24,77 +58,289 @@ KMeansClustering::KMeansClustering(int k, int maxIterations)
     }
 }
 
-double KMeansClustering::euclideanDistance(const std::vector<double>& a, const std::vector<double>& b) const
+void PointMatrix::assign(const std::vector<std::vector<double>>& X)
+{
+    numRows = X.size();
+    numFeatures = X.empty() ? 0 : X[0].size();
+    values.resize(numRows * numFeatures);
+
+    double* out = values.data();
+    for (const auto& point : X)
+    {
+        if (point.size() != numFeatures)
+        {
+            throw ValidationException("All points must have the same number of features", "KMean");
+        }
+        out = std::copy(point.begin(), point.end(), out);
+    }
+}
+
+const double* PointMatrix::row(size_t i) const
+{
+    return values.data() + i * numFeatures;
+}
+
+double KMeansClustering::squaredDistance(const double* a, const double* b, size_t numFeatures)
 {
     double sumSquared = 0.0;
-    for (size_t i = 0; i < a.size(); ++i)
+    for (size_t i = 0; i < numFeatures; ++i)
     {
         double diff = a[i] - b[i];
         sumSquared += diff * diff;
     }
-    return std::sqrt(sumSquared);
+    return sumSquared;
+}
+
+double KMeansClustering::euclideanDistance(const std::vector<double>& a, const std::vector<double>& b)
+{
+    return std::sqrt(squaredDistance(a.data(), b.data(), a.size()));
 }
 
-void KMeansClustering::initializeCentroids(const std::vector<std::vector<double>>& X)
+void KMeansClustering::refreshCentroidBlock()
 {
-    size_t n = X.size();
+    size_t numFeatures = _centroids[0].size();
+    _centroidStride = (_k + DISTANCE_KERNEL_LANES - 1) / DISTANCE_KERNEL_LANES * DISTANCE_KERNEL_LANES;
+    _centroidBlock.assign(numFeatures * _centroidStride, 0.0);
 
-    std::vector<size_t> indices(n);
-    std::iota(indices.begin(), indices.end(), 0);
+    for (int c = 0; c < _k; ++c)
+    {
+        for (size_t f = 0; f < numFeatures; ++f)
+        {
+            _centroidBlock[f * _centroidStride + c] = _centroids[c][f];
+        }
+    }
+}
 
-    std::shuffle(indices.begin(), indices.end(), _randomEngine);
+void KMeansClustering::initializeCentroids(const PointMatrix& X)
+{
+    size_t n = X.numRows;
+    size_t numFeatures = X.numFeatures;
 
     _centroids.clear();
     _centroids.reserve(_k);
 
-    for (int i = 0; i < _k; ++i)
+    auto pointAt = [&X, numFeatures](size_t i) {
+        return std::vector<double>(X.row(i), X.row(i) + numFeatures);
+    };
+
+    std::uniform_int_distribution<size_t> pickAny(0, n - 1);
+    _centroids.push_back(pointAt(pickAny(_randomEngine)));
+
+    // k-means++: each next seed is drawn with probability proportional to its squared
+    // distance from the nearest seed so far, which spreads seeds across the clusters
+    std::vector<double> nearestSquared(n, std::numeric_limits<double>::max());
+    std::vector<double> partialTotals(workerCount(n));
+    auto absorbSeed = [&](const std::vector<double>& seed) {
+        forEachRange(n, [&](int worker, size_t begin, size_t end) {
+            double subtotal = 0.0;
+            for (size_t i = begin; i < end; ++i)
+            {
+                nearestSquared[i] = std::min(nearestSquared[i], squaredDistance(X.row(i), seed.data(), numFeatures));
+                subtotal += nearestSquared[i];
+            }
+            partialTotals[worker] = subtotal;
+        });
+        return std::accumulate(partialTotals.begin(), partialTotals.end(), 0.0);
+    };
+    double total = absorbSeed(_centroids[0]);
+
+    while (static_cast<int>(_centroids.size()) < _k)
     {
-        _centroids.push_back(X[indices[i]]);
+        size_t chosen = 0;
+        if (total > 0.0)
+        {
+            double target = std::uniform_real_distribution<double>(0.0, total)(_randomEngine);
+            double running = 0.0;
+            chosen = n - 1;
+            for (size_t i = 0; i < n; ++i)
+            {
+                running += nearestSquared[i];
+                if (running > target)
+                {
+                    chosen = i;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            chosen = pickAny(_randomEngine);  // every point already sits on a seed
+        }
+
+        _centroids.push_back(pointAt(chosen));
+        total = absorbSeed(_centroids.back());
     }
+
+    refreshCentroidBlock();
 }
 
-void KMeansClustering::assignClusters(const std::vector<std::vector<double>>& X)
+void KMeansClustering::assignClusters(const PointMatrix& X)
 {
-    _labels.resize(X.size());
+    size_t n = X.numRows;
+    size_t numFeatures = X.numFeatures;
+
+    // First pass: no bounds yet, scan everything
+    if (_upperBounds.size() != n)
+    {
+        _labels.resize(n);
+        _upperBounds.resize(n);
+        _lowerBounds.resize(n);
+        forEachRange(n, [&](int, size_t begin, size_t end) {
+            std::vector<double> distances(_centroidStride);
+            for (size_t i = begin; i < end; ++i)
+            {
+                _labels[i] = findTwoNearestCentroids(X.row(i), distances.data(), _upperBounds[i], _lowerBounds[i]);
+            }
+        });
+        return;
+    }
 
-    for (size_t i = 0; i < X.size(); ++i)
+    // Loosen the bounds by how far the centroids moved. The lower bound only needs the largest
+    // shift among the other centroids, hence the runner-up for points of the farthest mover.
+    int farthestCentroid = 0;
+    double largestShift = 0.0;
+    double secondLargestShift = 0.0;
+    for (int j = 0; j < _k; ++j)
     {
-        _labels[i] = findNearestCentroid(X[i]);
+        if (_centroidShifts[j] > largestShift)
+        {
+            secondLargestShift = largestShift;
+            largestShift = _centroidShifts[j];
+            farthestCentroid = j;
+        }
+        else if (_centroidShifts[j] > secondLargestShift)
+        {
+            secondLargestShift = _centroidShifts[j];
+        }
     }
+
+    // Half the distance to the nearest other centroid: anything closer than that to its own centroid stays
+    std::vector<double> halfGap(_k, std::numeric_limits<double>::max());
+    for (int a = 0; a < _k; ++a)
+    {
+        for (int b = a + 1; b < _k; ++b)
+        {
+            double half = 0.5 * euclideanDistance(_centroids[a], _centroids[b]);
+            halfGap[a] = std::min(halfGap[a], half);
+            halfGap[b] = std::min(halfGap[b], half);
+        }
+    }
+
+    // Every point only touches its own label and bounds, so ranges run independently.
+    // Raw pointers keep the compiler from reloading the vectors after every store.
+    int* labels = _labels.data();
+    double* upperBounds = _upperBounds.data();
+    double* lowerBounds = _lowerBounds.data();
+    const double* shifts = _centroidShifts.data();
+    const double* gaps = halfGap.data();
+
+    forEachRange(n, [&](int, size_t begin, size_t end) {
+        std::vector<double> distances(_centroidStride);
+        for (size_t i = begin; i < end; ++i)
+        {
+            int label = labels[i];
+            double upper = upperBounds[i] + shifts[label];
+            double lower = lowerBounds[i] - ((label == farthestCentroid) ? secondLargestShift : largestShift);
+            lowerBounds[i] = lower;
+
+            double bound = std::max(gaps[label], lower);
+            if (upper > bound)
+            {
+                // Tighten the upper bound with one exact distance before resorting to a full scan
+                upper = std::sqrt(squaredDistance(X.row(i), _centroids[label].data(), numFeatures));
+                if (upper > bound)
+                {
+                    labels[i] = findTwoNearestCentroids(X.row(i), distances.data(), upper, lowerBounds[i]);
+                }
+            }
+            upperBounds[i] = upper;
+        }
+    });
 }
 
-int KMeansClustering::findNearestCentroid(const std::vector<double>& points) const
+int KMeansClustering::findNearestCentroid(const double* point, double* distances) const
 {
-    int nearestCluster = 0;
-    double minDistance = std::numeric_limits<double>::max();
+    getDistanceKernel().squaredDistances(point, _centroids[0].size(), _centroidBlock.data(), _centroidStride, distances);
 
-    for (int i = 0; i < _k; ++i)
+    // Squared distances order the same way; no sqrt needed to pick the winner
+    int nearestCluster = 0;
+    for (int i = 1; i < _k; ++i)
     {
-        double dist = euclideanDistance(points, _centroids[i]);
-    
-        if (dist < minDistance)
+        if (distances[i] < distances[nearestCluster])
         {
-            minDistance = dist;
             nearestCluster = i;
         }
     }
     return nearestCluster;
 }
 
-bool KMeansClustering::updateCentroids(const std::vector<std::vector<double>>& X)
+int KMeansClustering::findTwoNearestCentroids(const double* point, double* distances, double& nearestDistance, double& secondDistance) const
 {
-    size_t numFeatures = X[0].size();
-    std::vector<std::vector<double>> newCentroids(_k, std::vector<double>(numFeatures, 0.0));
-    std::vector<int> clusterCounts(_k, 0);
+    getDistanceKernel().squaredDistances(point, _centroids[0].size(), _centroidBlock.data(), _centroidStride, distances);
+
+    int nearestCluster = 0;
+    double nearest = std::numeric_limits<double>::max();
+    double second = std::numeric_limits<double>::max();
 
-    for (size_t i = 0; i < X.size(); ++i)
+    for (int j = 0; j < _k; ++j)
     {
-        int cluster = _labels[i];
-        clusterCounts[cluster]++;
+        double dist = distances[j];
+        if (dist < nearest)
+        {
+            second = nearest;
+            nearest = dist;
+            nearestCluster = j;
+        }
+        else if (dist < second)
+        {
+            second = dist;
+        }
+    }
 
-        for (size_t j = 0; j < numFeatures; ++j)
+    nearestDistance = std::sqrt(nearest);
+    secondDistance = std::sqrt(second);  // stays at max() when k == 1, so the point is never rescanned
+    return nearestCluster;
+}
+
+bool KMeansClustering::updateCentroids(const PointMatrix& X)
+{
+    size_t numFeatures = X.numFeatures;
+    size_t stride = static_cast<size_t>(_k) * numFeatures;
+
+    // Each worker sums its own range into private buffers; the reduction runs in worker order
+    int numWorkers = workerCount(X.numRows);
+    std::vector<double> partialSums(numWorkers * stride, 0.0);
+    std::vector<size_t> partialCounts(numWorkers * _k, 0);
+
+    forEachRange(X.numRows, [&](int worker, size_t begin, size_t end) {
+        double* sums = partialSums.data() + worker * stride;
+        size_t* counts = partialCounts.data() + worker * _k;
+        for (size_t i = begin; i < end; ++i)
+        {
+            int cluster = _labels[i];
+            ++counts[cluster];
+
+            double* clusterSums = sums + cluster * numFeatures;
+            const double* point = X.row(i);
+            for (size_t j = 0; j < numFeatures; ++j)
+            {
+                clusterSums[j] += point[j];
+            }
+        }
+    });
+
+    std::vector<std::vector<double>> newCentroids(_k, std::vector<double>(numFeatures, 0.0));
+    std::vector<size_t> clusterCounts(_k, 0);
+    for (int w = 0; w < numWorkers; ++w)
+    {
+        for (int c = 0; c < _k; ++c)
         {
-            newCentroids[cluster][j] += X[i][j];
+            clusterCounts[c] += partialCounts[w * _k + c];
+            const double* sums = partialSums.data() + w * stride + c * numFeatures;
+            for (size_t j = 0; j < numFeatures; ++j)
+            {
+                newCentroids[c][j] += sums[j];
+            }
         }
     }
 
@@ -114,33 +360,52 @@ bool KMeansClustering::updateCentroids(const std::vector<std::vector<double>>& X
     }
 
     double totalShift = 0.0;
+    _centroidShifts.resize(_k);
     for (int i = 0; i < _k; ++i)
     {
-        totalShift += euclideanDistance(_centroids[i], newCentroids[i]);
+        _centroidShifts[i] = euclideanDistance(_centroids[i], newCentroids[i]);
+        totalShift += _centroidShifts[i];
     }
 
     _centroids = std::move(newCentroids);
+    refreshCentroidBlock();
 
     return totalShift < KMEANS_TOLERANCE;
 }
 
 void KMeansClustering::train(const std::vector<std::vector<double>>& X)
 {
-    if (X.empty())
+    PointMatrix points;
+    points.assign(X);
+    train(points);
+}
+
+void KMeansClustering::train(const PointMatrix& X)
+{
+    if ((X.numRows == 0)
+    || (X.numFeatures == 0))
     {
         throw ValidationException("Training data cannot be empty", "KMean");
     }
 
-    if (static_cast<int>(X.size()) < _k)
+    if (static_cast<int>(X.numRows) < _k)
     {
         throw ValidationException("Not enough data points for K clusters", "KMean");
     }
 
+    // Seeding and every Lloyd phase hand their ranges to the same threads
+    WorkerPool workers(workerCount(X.numRows));
+    WorkerLease lease(_workers, workers);
+
     initializeCentroids(X);
+    _upperBounds.clear();
+    _lowerBounds.clear();
+    _iterations = 0;
 
     for (int iter = 0; iter < _maxIterations; ++iter)
     {
         assignClusters(X);
+        ++_iterations;
 
         bool converged = updateCentroids(X);
 
@@ -149,9 +414,125 @@ void KMeansClustering::train(const std::vector<std::vector<double>>& X)
             break;
         }
     }
+
+    _upperBounds = {};
+    _lowerBounds = {};
+    _centroidShifts = {};
+    _centroidCounts.clear();
+
+    computeInertia(X);
+    _isTrained = true;
+}
+
+void KMeansClustering::partialFit(const std::vector<std::vector<double>>& batch)
+{
+    _batchPoints.assign(batch);
+    partialFit(_batchPoints);
+}
+
+void KMeansClustering::partialFit(const PointMatrix& batch)
+{
+    if (batch.numRows == 0)
+    {
+        return;
+    }
+
+    WorkerPool workers(workerCount(batch.numRows));
+    WorkerLease lease(_workers, workers);
+
+    if (_centroidCounts.empty())
+    {
+        if (static_cast<int>(batch.numRows) < _k)
+        {
+            throw ValidationException("First mini-batch must hold at least K points", "KMean");
+        }
+        initializeCentroids(batch);
+        _centroidCounts.assign(_k, 0.0);
+        _iterations = 0;
+        _inertia = 0.0;
+    }
+    else if (batch.numFeatures != _centroids[0].size())
+    {
+        throw ValidationException("Mini-batch features size does not match trained features size", "KMean");
+    }
+
+    // Assign the whole batch against the current centroids first, then move each centroid
+    // towards its points with a per-centroid rate of 1 / (points seen), i.e. a running mean
+    _labels.resize(batch.numRows);
+    forEachRange(batch.numRows, [&](int, size_t begin, size_t end) {
+        std::vector<double> distances(_centroidStride);
+        for (size_t i = begin; i < end; ++i)
+        {
+            _labels[i] = findNearestCentroid(batch.row(i), distances.data());
+        }
+    });
+
+    size_t numFeatures = batch.numFeatures;
+    for (size_t i = 0; i < batch.numRows; ++i)
+    {
+        int cluster = _labels[i];
+        _centroidCounts[cluster] += 1.0;
+        double rate = 1.0 / _centroidCounts[cluster];
+
+        auto& centroid = _centroids[cluster];
+        const double* point = batch.row(i);
+        for (size_t j = 0; j < numFeatures; ++j)
+        {
+            centroid[j] += rate * (point[j] - centroid[j]);
+        }
+    }
+    refreshCentroidBlock();
+
+    ++_iterations;
     _isTrained = true;
 }
 
+void KMeansClustering::computeInertia(const PointMatrix& X)
+{
+    std::vector<double> partialInertia(workerCount(X.numRows), 0.0);
+    forEachRange(X.numRows, [&](int worker, size_t begin, size_t end) {
+        double subtotal = 0.0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            subtotal += squaredDistance(X.row(i), _centroids[_labels[i]].data(), X.numFeatures);
+        }
+        partialInertia[worker] = subtotal;
+    });
+    _inertia = std::accumulate(partialInertia.begin(), partialInertia.end(), 0.0);
+}
+
+int KMeansClustering::workerCount(size_t count) const
+{
+    int numThreads = _numThreads > 0 ? _numThreads : static_cast<int>(std::thread::hardware_concurrency());
+    size_t usefulThreads = (count + KMEANS_MIN_POINTS_PER_THREAD - 1) / KMEANS_MIN_POINTS_PER_THREAD;
+    return std::clamp(static_cast<int>(std::min<size_t>(usefulThreads, numThreads)), 1, std::max(1, numThreads));
+}
+
+void KMeansClustering::forEachRange(size_t count, const std::function<void(int, size_t, size_t)>& body) const
+{
+    int numWorkers = workerCount(count);
+    if (numWorkers == 1)
+    {
+        body(0, 0, count);
+        return;
+    }
+
+    auto range = [&](int workerIdx) {
+        size_t begin = count * workerIdx / numWorkers;
+        size_t end = count * (workerIdx + 1) / numWorkers;
+        body(workerIdx, begin, end);
+    };
+
+    if (_workers)
+    {
+        _workers->run(numWorkers, range);
+    }
+    else
+    {
+        runParallel(numWorkers, numWorkers, range);
+    }
+}
+
 ClusterResult KMeansClustering::predict(const std::vector<double>& points) const
 {
     if (!_isTrained)
@@ -169,8 +550,9 @@ ClusterResult KMeansClustering::predict(const std::vector<double>& points) const
         );
     }
 
-    int clusterId = findNearestCentroid(points);
-    double distance = euclideanDistance(points, _centroids[clusterId]);
+    std::vector<double> distances(_centroidStride);
+    int clusterId = findNearestCentroid(points.data(), distances.data());
+    double distance = std::sqrt(distances[clusterId]);
 
     return ClusterResult {
         clusterId,
@@ -181,24 +563,94 @@ ClusterResult KMeansClustering::predict(const std::vector<double>& points) const
 
 std::vector<int> KMeansClustering::predictBatch(const std::vector<std::vector<double>>& X) const
 {
-    std::vector<int> predictions;
-    predictions.reserve(X.size());
+    if (!_isTrained)
+    {
+        throw ValidationException("Model must be trained before prediction", "KMean");
+    }
 
-    for (const auto& point : X)
+    PointMatrix points;
+    points.assign(X);
+    if ((points.numRows > 0)
+    && (points.numFeatures != _centroids[0].size()))
     {
-        predictions.push_back(predict(point).clusterId);
+        throw ValidationException("Input features size does not match trained features size", "KMean");
     }
 
+    std::vector<int> predictions(points.numRows);
+    forEachRange(points.numRows, [&](int, size_t begin, size_t end) {
+        std::vector<double> distances(_centroidStride);
+        for (size_t i = begin; i < end; ++i)
+        {
+            predictions[i] = findNearestCentroid(points.row(i), distances.data());
+        }
+    });
+
     return predictions;
 }
 
 double KMeansClustering::getInertia() const
 {
-    return 0.0;
+    return _inertia;
+}
+
+void KMeansClustering::saveModel(const std::string& path) const
+{
+    if (!_isTrained)
+    {
+        throw ValidationException("Model must be trained before saving", "KMean");
+    }
+
+    size_t numFeatures = _centroids[0].size();
+    std::vector<double> flat;
+    flat.reserve(_k * numFeatures);
+    for (const auto& centroid : _centroids)
+    {
+        flat.insert(flat.end(), centroid.begin(), centroid.end());
+    }
+
+    ModelWriter writer(ModelType::KMeans);
+    writer.writeValue<int32_t>(_k);
+    writer.writeValue<int32_t>(_maxIterations);
+    writer.writeValue<int32_t>(static_cast<int32_t>(numFeatures));
+    writer.writeArray(std::span<const double>(flat));
+    writer.saveToFile(path);
+}
+
+void KMeansClustering::loadModel(const std::string& path)
+{
+    ModelReader reader(std::make_shared<const MappedFile>(path), ModelType::KMeans);
+
+    int k = reader.readValue<int32_t>();
+    int maxIterations = reader.readValue<int32_t>();
+    int numFeatures = reader.readValue<int32_t>();
+    auto flat = reader.readArray<double>();
+
+    if ((k <= 0)
+    || (numFeatures <= 0)
+    || (flat.size() != static_cast<size_t>(k) * numFeatures))
+    {
+        throw ValidationException("Corrupt KMeans model: centroid array size mismatch", "modelPath");
+    }
+
+    // k x features doubles is tiny, so centroids are copied out and the mapping released
+    _centroids.assign(k, std::vector<double>(numFeatures));
+    for (int i = 0; i < k; ++i)
+    {
+        std::copy(flat.begin() + i * numFeatures, flat.begin() + (i + 1) * numFeatures, _centroids[i].begin());
+    }
+    _k = k;
+    _maxIterations = maxIterations;
+    _labels.clear();
+    _inertia = 0.0;
+    refreshCentroidBlock();
+    _isTrained = true;
 }
 
 bool KMeansClustering::isTrained() const { return _isTrained; }
 int KMeansClustering::getK() const { return _k; }
+int KMeansClustering::getIterations() const { return _iterations; }
+void KMeansClustering::setSeed(uint32_t seed) { _randomEngine.seed(seed); }
+void KMeansClustering::setNumThreads(int numThreads) { _numThreads = numThreads; }
 const std::vector<std::vector<double>>& KMeansClustering::getCentroids() const { return _centroids; }
 const std::vector<int>& KMeansClustering::getLabels() const { return _labels; }
 
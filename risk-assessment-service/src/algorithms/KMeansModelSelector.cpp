@@ -0,0 +1,216 @@
+// KMeansModelSelector.cpp - Implementation
+
+#include "../../include/algorithms/KMeansModelSelector.h"
+#include "../../include/algorithms/ParallelTasks.h"
+#include "../../../common/include/exceptions/ValidationException.h"
+#include <numeric>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <mutex>
+
+using namespace sdrs::constants::risk;
+using namespace sdrs::exceptions;
+
+namespace sdrs::risk
+{
+
+KMeansModelSelector::KMeansModelSelector(int minK, int maxK, int restarts)
+    : _minK(minK),
+    _maxK(std::min(maxK, KMEANS_AUTO_K_LIMIT)),
+    _restarts(std::min(restarts, KMEANS_AUTO_RESTARTS_LIMIT)),
+    _silhouetteSamples(KMEANS_SILHOUETTE_SAMPLES),
+    _seed(std::random_device{}()),
+    _numThreads(0)
+{
+    // Silhouette needs at least two clusters to compare against
+    if (minK < 2)
+    {
+        throw ValidationException("Minimum K must be at least 2", "min_k");
+    }
+
+    if (minK > KMEANS_AUTO_K_LIMIT)
+    {
+        throw ValidationException("Minimum K must be at most " + std::to_string(KMEANS_AUTO_K_LIMIT), "min_k");
+    }
+
+    if (maxK < minK)
+    {
+        throw ValidationException("Maximum K must not be less than minimum K", "max_k");
+    }
+
+    if (restarts <= 0)
+    {
+        throw ValidationException("Restarts must be positive", "restarts");
+    }
+}
+
+KSelectionResult KMeansModelSelector::select(const PointMatrix& X) const
+{
+    // Every k needs more points than clusters
+    int maxK = static_cast<int>(std::min<size_t>(_maxK, X.numRows > 0 ? X.numRows - 1 : 0));
+    if (maxK < _minK)
+    {
+        throw ValidationException("Need more data points than the minimum K", "KMean");
+    }
+
+    int numK = maxK - _minK + 1;
+    int numRuns = numK * _restarts;
+
+    // Only the lowest-inertia restart of each k is kept, so at most one model per k (plus one
+    // per worker in flight) holds labels for every row. Ties go to the lower restart, and run r
+    // of k gets its own seed, so results do not depend on which worker picks a run up.
+    std::vector<KMeansClustering> bestOfK(numK);
+    std::vector<int> bestRestart(numK, -1);
+    std::mutex bestMutex;
+    runParallel(numRuns, _numThreads, [&](int run) {
+        int i = run / _restarts;
+        int k = _minK + i;
+        int restart = run % _restarts;
+
+        std::seed_seq seeds{_seed, static_cast<uint32_t>(k), static_cast<uint32_t>(restart)};
+        uint32_t runSeed;
+        seeds.generate(&runSeed, &runSeed + 1);
+
+        KMeansClustering kmeans(k);
+        kmeans.setSeed(runSeed);
+        kmeans.setNumThreads(1);
+        kmeans.train(X);
+
+        std::lock_guard<std::mutex> lock(bestMutex);
+        if ((bestRestart[i] < 0)
+        || (kmeans.getInertia() < bestOfK[i].getInertia())
+        || ((kmeans.getInertia() == bestOfK[i].getInertia()) && (restart < bestRestart[i])))
+        {
+            bestOfK[i] = std::move(kmeans);
+            bestRestart[i] = restart;
+        }
+    });
+
+    std::vector<size_t> sample(X.numRows);
+    std::iota(sample.begin(), sample.end(), 0);
+    if (sample.size() > _silhouetteSamples)
+    {
+        std::mt19937 randomEngine(_seed);
+        std::shuffle(sample.begin(), sample.end(), randomEngine);
+        sample.resize(_silhouetteSamples);
+    }
+
+    KSelectionResult result;
+    result.silhouetteSamples = sample.size();
+    result.candidates.resize(numK);
+    runParallel(numK, _numThreads, [&](int i) {
+        const auto& kmeans = bestOfK[i];
+        result.candidates[i] = KCandidate{
+            kmeans.getK(),
+            kmeans.getInertia(),
+            silhouette(X, sample, kmeans.getLabels(), kmeans.getK()),
+            kmeans.getIterations()
+        };
+    });
+
+    int best = 0;
+    for (int i = 1; i < numK; ++i)
+    {
+        if (result.candidates[i].silhouette > result.candidates[best].silhouette)
+        {
+            best = i;
+        }
+    }
+
+    result.bestK = result.candidates[best].k;
+    result.elbowK = findElbow(result.candidates);
+    result.model = std::move(bestOfK[best]);
+    result.model.setNumThreads(_numThreads);
+    return result;
+}
+
+double KMeansModelSelector::silhouette(const PointMatrix& X, const std::vector<size_t>& sample, const std::vector<int>& labels, int k)
+{
+    std::vector<double> clusterSums(k);
+    std::vector<size_t> clusterCounts(k, 0);
+    for (size_t i : sample)
+    {
+        ++clusterCounts[labels[i]];
+    }
+
+    double total = 0.0;
+    for (size_t i : sample)
+    {
+        const double* point = X.row(i);
+        std::fill(clusterSums.begin(), clusterSums.end(), 0.0);
+        for (size_t j : sample)
+        {
+            const double* other = X.row(j);
+            double sumSquared = 0.0;
+            for (size_t f = 0; f < X.numFeatures; ++f)
+            {
+                double diff = point[f] - other[f];
+                sumSquared += diff * diff;
+            }
+            clusterSums[labels[j]] += std::sqrt(sumSquared);
+        }
+
+        // A point alone in its cluster scores 0 by convention
+        int own = labels[i];
+        if (clusterCounts[own] <= 1)
+        {
+            continue;
+        }
+
+        double cohesion = clusterSums[own] / (clusterCounts[own] - 1);
+        double separation = std::numeric_limits<double>::max();
+        for (int c = 0; c < k; ++c)
+        {
+            if ((c != own)
+            && (clusterCounts[c] > 0))
+            {
+                separation = std::min(separation, clusterSums[c] / clusterCounts[c]);
+            }
+        }
+
+        double scale = std::max(cohesion, separation);
+        if ((separation < std::numeric_limits<double>::max())
+        && (scale > 0.0))
+        {
+            total += (separation - cohesion) / scale;
+        }
+    }
+
+    return total / sample.size();
+}
+
+int KMeansModelSelector::findElbow(const std::vector<KCandidate>& candidates)
+{
+    // Kneedle: normalize both axes to [0, 1] and take the point farthest below the chord
+    // from the first to the last candidate
+    double maxInertia = candidates.front().inertia;
+    double minInertia = candidates.back().inertia;
+    if ((candidates.size() < 3)
+    || (maxInertia <= minInertia))
+    {
+        return candidates.front().k;
+    }
+
+    double span = static_cast<double>(candidates.size() - 1);
+    int elbow = candidates.front().k;
+    double bestGap = 0.0;
+    for (size_t i = 1; i + 1 < candidates.size(); ++i)
+    {
+        double x = i / span;
+        double y = (candidates[i].inertia - minInertia) / (maxInertia - minInertia);
+        double gap = (1.0 - x) - y;
+        if (gap > bestGap)
+        {
+            bestGap = gap;
+            elbow = candidates[i].k;
+        }
+    }
+    return elbow;
+}
+
+void KMeansModelSelector::setSeed(uint32_t seed) { _seed = seed; }
+void KMeansModelSelector::setNumThreads(int numThreads) { _numThreads = numThreads; }
+void KMeansModelSelector::setSilhouetteSamples(size_t samples) { _silhouetteSamples = std::max<size_t>(samples, 2); }
+
+}
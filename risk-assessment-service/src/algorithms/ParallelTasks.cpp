@@ -0,0 +1,181 @@
+// ParallelTasks.cpp - Implementation
+
+#include "../../include/algorithms/ParallelTasks.h"
+#include <algorithm>
+#include <utility>
+
+namespace sdrs::risk
+{
+
+void runParallel(int numTasks, int numThreads, const std::function<void(int)>& task)
+{
+    if (numThreads <= 0)
+    {
+        numThreads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    numThreads = std::clamp(numThreads, 1, std::max(1, numTasks));
+
+    // Workers pull task indices from a shared counter
+    std::atomic<int> nextTask{0};
+    std::vector<std::exception_ptr> errors(numThreads);
+    auto worker = [&](int workerIdx) {
+        try
+        {
+            for (int i = nextTask++; i < numTasks; i = nextTask++)
+            {
+                task(i);
+            }
+        }
+        catch (...)
+        {
+            errors[workerIdx] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(numThreads - 1);
+    for (int t = 1; t < numThreads; ++t)
+    {
+        workers.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : workers)
+    {
+        thread.join();
+    }
+
+    for (const auto& error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+WorkerPool::WorkerPool(int numThreads)
+    : _task(nullptr),
+    _numTasks(0),
+    _nextTask(0),
+    _generation(0),
+    _busyWorkers(0),
+    _stopping(false)
+{
+    if (numThreads <= 0)
+    {
+        numThreads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+
+    _threads.reserve(std::max(numThreads, 1) - 1);
+    for (int t = 1; t < numThreads; ++t)
+    {
+        _threads.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _wake.notify_all();
+    for (auto& thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+int WorkerPool::size() const
+{
+    return static_cast<int>(_threads.size()) + 1;
+}
+
+void WorkerPool::run(int numTasks, const std::function<void(int)>& task)
+{
+    if (_threads.empty())
+    {
+        for (int i = 0; i < numTasks; ++i)
+        {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = &task;
+        _numTasks = numTasks;
+        _nextTask = 0;
+        _error = nullptr;
+        _busyWorkers = static_cast<int>(_threads.size());
+        ++_generation;
+    }
+    _wake.notify_all();
+
+    drain(task, numTasks);
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle.wait(lock, [this] { return _busyWorkers == 0; });
+        _task = nullptr;
+        error = std::exchange(_error, nullptr);
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+void WorkerPool::workerLoop()
+{
+    uint64_t seenGeneration = 0;
+    while (true)
+    {
+        const std::function<void(int)>* task;
+        int numTasks;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [&] { return _stopping || (_generation != seenGeneration); });
+            if (_stopping)
+            {
+                return;
+            }
+            seenGeneration = _generation;
+            task = _task;
+            numTasks = _numTasks;
+        }
+
+        drain(*task, numTasks);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (--_busyWorkers == 0)
+        {
+            _idle.notify_one();
+        }
+    }
+}
+
+// Pulls task indices from the shared counter until none are left; only the first failure is kept
+void WorkerPool::drain(const std::function<void(int)>& task, int numTasks)
+{
+    try
+    {
+        for (int i = _nextTask++; i < numTasks; i = _nextTask++)
+        {
+            task(i);
+        }
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_error)
+        {
+            _error = std::current_exception();
+        }
+    }
+}
+
+}
@@ -1,12 +1,15 @@
 // RandomForest.cpp - Implementation
 
 #include "../../include/algorithms/RandomForest.h"
+#include "../../include/algorithms/ParallelTasks.h"
+#include "../../include/models/ModelArtifact.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
 #include <limits>
 
 using namespace sdrs::constants::risk;
+using namespace sdrs::exceptions;
 
 namespace sdrs::risk
 {
@@ -26,57 +29,311 @@ bool TreeNode::isLeaf() const
     return featureIndex == RF_LEAF_FEATURES_INDEX;
 }
 
+void FlatForest::clear()
+{
+    featureIndices.clear();
+    thresholds.clear();
+    leftChildren.clear();
+    rightChildren.clear();
+    leafValues.clear();
+    treeRoots.clear();
+}
+
+bool FlatForest::empty() const
+{
+    return treeRoots.empty();
+}
+
+size_t FlatForest::getNodeCount() const
+{
+    return featureIndices.size();
+}
+
+int FlatForest::appendNode()
+{
+    featureIndices.push_back(RF_LEAF_FEATURES_INDEX);
+    thresholds.push_back(0.0);
+    leftChildren.push_back(RF_LEAF_FEATURES_INDEX);
+    rightChildren.push_back(RF_LEAF_FEATURES_INDEX);
+    leafValues.push_back(0.0);
+    return static_cast<int>(featureIndices.size()) - 1;
+}
+
+FlatForestView FlatForest::view() const
+{
+    FlatForestView view;
+    view.featureIndices = featureIndices.data();
+    view.thresholds = thresholds.data();
+    view.leftChildren = leftChildren.data();
+    view.rightChildren = rightChildren.data();
+    view.leafValues = leafValues.data();
+    view.treeRoots = treeRoots.data();
+    view.nodeCount = featureIndices.size();
+    view.numTrees = treeRoots.size();
+    return view;
+}
+
+bool FlatForestView::empty() const
+{
+    return numTrees == 0;
+}
+
+double FlatForestView::predictTree(size_t treeIndex, const double* features) const
+{
+    int node = treeRoots[treeIndex];
+    while (featureIndices[node] != RF_LEAF_FEATURES_INDEX)
+    {
+        node = (features[featureIndices[node]] < thresholds[node]) ? leftChildren[node] : rightChildren[node];
+    }
+    return leafValues[node];
+}
+
+double FlatForestView::predict(const double* features) const
+{
+    if (numTrees == 0)
+    {
+        return 0.0;
+    }
+
+    double sum = 0.0;
+    for (size_t t = 0; t < numTrees; ++t)
+    {
+        sum += predictTree(t, features);
+    }
+    return sum / numTrees;
+}
+
+void FlatForestView::predictBatch(const double* columns, size_t numRows, double* out) const
+{
+    std::fill(out, out + numRows, 0.0);
+    if (numTrees == 0) return;
+
+    int nodes[RF_BATCH_BLOCK_SIZE];
+
+    // Rows are processed in blocks; within a block every tree is walked one level at a time
+    // for all rows together, so the inner loop is a flat gather/compare over the block
+    for (size_t start = 0; start < numRows; start += RF_BATCH_BLOCK_SIZE)
+    {
+        size_t count = std::min(RF_BATCH_BLOCK_SIZE, numRows - start);
+        const double* block = columns + start;
+
+        for (size_t t = 0; t < numTrees; ++t)
+        {
+            std::fill(nodes, nodes + count, treeRoots[t]);
+
+            bool active = true;
+            while (active)
+            {
+                active = false;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    int node = nodes[i];
+                    int feature = featureIndices[node];
+                    if (feature == RF_LEAF_FEATURES_INDEX) continue;
+
+                    nodes[i] = (block[feature * numRows + i] < thresholds[node]) ? leftChildren[node] : rightChildren[node];
+                    active = true;
+                }
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                out[start + i] += leafValues[nodes[i]];
+            }
+        }
+    }
+
+    double scale = 1.0 / numTrees;
+    for (size_t i = 0; i < numRows; ++i)
+    {
+        out[i] *= scale;
+    }
+}
+
+void FeatureMatrix::build(const std::vector<std::vector<double>>& X)
+{
+    numRows = X.size();
+    numFeatures = X.empty() ? 0 : X[0].size();
+    
+    values.resize(numRows * numFeatures);
+    sortedRows.assign(numFeatures, std::vector<int>(numRows));
+    
+    for (size_t f = 0; f < numFeatures; ++f)
+    {
+        double* col = values.data() + f * numRows;
+        for (size_t i = 0; i < numRows; ++i)
+        {
+            col[i] = X[i][f];
+        }
+        
+        auto& order = sortedRows[f];
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [col](int a, int b) {
+            return col[a] < col[b];
+        });
+    }
+}
+
+const double* FeatureMatrix::column(size_t feature) const
+{
+    return values.data() + feature * numRows;
+}
+
+void BinnedFeatures::build(const std::vector<std::vector<double>>& X, int maxBins)
+{
+    numRows = X.size();
+    numFeatures = X.empty() ? 0 : X[0].size();
+    maxBins = std::clamp(maxBins, 2, RF_HISTOGRAM_MAX_BINS);
+    
+    bins.assign(numRows * numFeatures, 0);
+    cutPoints.assign(numFeatures, {});
+    
+    std::vector<double> values(numRows);
+    for (size_t f = 0; f < numFeatures; ++f)
+    {
+        for (size_t i = 0; i < numRows; ++i)
+        {
+            values[i] = X[i][f];
+        }
+        std::sort(values.begin(), values.end());
+        
+        auto& cuts = cutPoints[f];
+        size_t distinctCount = 1;
+        for (size_t i = 1; i < numRows; ++i)
+        {
+            distinctCount += (values[i - 1] < values[i]) ? 1 : 0;
+        }
+        
+        if (distinctCount <= static_cast<size_t>(maxBins))
+        {
+            // Few distinct values: one bin each, cut halfway between neighbours (same splits as exact mode)
+            for (size_t i = 1; i < numRows; ++i)
+            {
+                if (values[i - 1] < values[i])
+                {
+                    double cut = values[i - 1] + (values[i] - values[i - 1]) * 0.5;
+                    cuts.push_back((values[i - 1] < cut) ? cut : values[i]);
+                }
+            }
+        }
+        else
+        {
+            // Quantile cuts so every bin holds roughly the same number of rows
+            for (int b = 1; b < maxBins; ++b)
+            {
+                double cut = values[b * numRows / maxBins];
+                if ((cut > values.front())
+                && (cuts.empty() || cut > cuts.back()))
+                {
+                    cuts.push_back(cut);
+                }
+            }
+        }
+        
+        uint8_t* column = bins.data() + f * numRows;
+        for (size_t i = 0; i < numRows; ++i)
+        {
+            column[i] = static_cast<uint8_t>(std::upper_bound(cuts.begin(), cuts.end(), X[i][f]) - cuts.begin());
+        }
+    }
+}
+
+const uint8_t* BinnedFeatures::column(size_t feature) const
+{
+    return bins.data() + feature * numRows;
+}
+
 DecisionTree::DecisionTree(int maxDepth, int minSamplesSplit)
     : _root(nullptr),
     _maxDepth(maxDepth),
     _minSamplesSplit(minSamplesSplit),
     _currentDepth(0),
-    _randomEngine(std::random_device{}())
+    _sampleCount(0)
 {
     // Do nothing
 }
 
 DecisionTree::~DecisionTree() = default;
 
-void DecisionTree::train(const std::vector<std::vector<double>>& X, const std::vector<double>& y)
+void DecisionTree::train(const FeatureMatrix& matrix, const std::vector<double>& y, const std::vector<int>& sampleCounts)
 {
-    if ((X.empty())
-    || (y.empty())
-    || (X.size() != y.size()))
+    if ((matrix.numRows == 0)
+    || (y.size() != matrix.numRows)
+    || (sampleCounts.size() != matrix.numRows))
     {
         return;
     }
     
-    _root = buildTree(X, y, 0);
+    _sampleCount = 0;
+    for (int count : sampleCounts)
+    {
+        _sampleCount += count;
+    }
+    if (_sampleCount == 0) return;
+    
+    // Expand the forest-wide sort order by the bootstrap counts: no per-tree sort, no row copies
+    _sortedSamples.resize(matrix.numFeatures * _sampleCount);
+    for (size_t f = 0; f < matrix.numFeatures; ++f)
+    {
+        int* segment = _sortedSamples.data() + f * _sampleCount;
+        size_t pos = 0;
+        for (int row : matrix.sortedRows[f])
+        {
+            for (int c = 0; c < sampleCounts[row]; ++c)
+            {
+                segment[pos++] = row;
+            }
+        }
+    }
+    
+    _scratch.resize(_sampleCount);
+    _goesLeft.assign(matrix.numRows, 0);
+    _featureImportances.assign(matrix.numFeatures, 0.0);
+    
+    _root = buildTree(matrix, y, 0, _sampleCount, 0);
     _currentDepth = 0;
+    
+    _sortedSamples = {};
+    _scratch = {};
+    _goesLeft = {};
 }
 
 std::unique_ptr<TreeNode> DecisionTree::buildTree(
-    const std::vector<std::vector<double>>& X,
+    const FeatureMatrix& matrix,
     const std::vector<double>& y,
+    size_t begin,
+    size_t end,
     int depth)
 {
     auto node = std::make_unique<TreeNode>();
     
+    const int* samples = _sortedSamples.data();
+    size_t sampleCount = end - begin;
+    
+    double sum = 0.0;
+    double sumSquared = 0.0;
+    for (size_t pos = begin; pos < end; ++pos)
+    {
+        double label = y[samples[pos]];
+        sum += label;
+        sumSquared += label * label;
+    }
+    double mean = sampleCount > 0 ? sum / sampleCount : 0.0;
+    node->leafValue = mean;
+    
     if (depth >= _maxDepth)
     {
-        node->featureIndex = RF_LEAF_FEATURES_INDEX;
-        node->leafValue = calculateMean(y);
         return node;
     }
     
-    if (X.size() < static_cast<size_t>(_minSamplesSplit))
+    if (sampleCount < static_cast<size_t>(_minSamplesSplit))
     {
-        node->featureIndex = RF_LEAF_FEATURES_INDEX;
-        node->leafValue = calculateMean(y);
         return node;
     }
     
-    double variance = calculateVariance(y);
+    double variance = sumSquared / sampleCount - mean * mean;
     if (variance < RF_VARIANCE_EPSILON)
     {
-        node->featureIndex = RF_LEAF_FEATURES_INDEX;
-        node->leafValue = calculateMean(y);
         return node;
     }
     
@@ -84,40 +341,39 @@ std::unique_ptr<TreeNode> DecisionTree::buildTree(
     double bestThreshold = 0.0;
     double bestGain = 0.0;
     
-    findBestSplit(X, y, bestFeature, bestThreshold, bestGain);
+    findBestSplit(matrix, y, begin, end, variance, bestFeature, bestThreshold, bestGain);
     
     if ((bestFeature == RF_LEAF_FEATURES_INDEX)
     || (bestGain <= 0.0))
     {
-        node->featureIndex = RF_LEAF_FEATURES_INDEX;
-        node->leafValue = calculateMean(y);
         return node;
     }
     
-    std::vector<std::vector<double>> leftX, rightX;
-    std::vector<double> leftY, rightY;
-    
-    splitData(X, y, bestFeature, bestThreshold, leftX, leftY, rightX, rightY);
+    size_t leftCount = partitionSamples(matrix, begin, end, bestFeature, bestThreshold);
     
-    if ((leftX.empty())
-    || (rightX.empty()))
+    if ((leftCount == 0)
+    || (leftCount == sampleCount))
     {
-        node->featureIndex = RF_LEAF_FEATURES_INDEX;
-        node->leafValue = calculateMean(y);
         return node;
     }
     
+    // Gain is a per-sample variance decrease; weighting by node size makes it additive over the tree
+    _featureImportances[bestFeature] += sampleCount * bestGain;
+    
     node->featureIndex = bestFeature;
     node->threshold = bestThreshold;
-    node->leftChild = buildTree(leftX, leftY, depth + 1);
-    node->rightChild = buildTree(rightX, rightY, depth + 1);
+    node->leftChild = buildTree(matrix, y, begin, begin + leftCount, depth + 1);
+    node->rightChild = buildTree(matrix, y, begin + leftCount, end, depth + 1);
     
     return node;
 }
 
 void DecisionTree::findBestSplit(
-    const std::vector<std::vector<double>>& X,
+    const FeatureMatrix& matrix,
     const std::vector<double>& y,
+    size_t begin,
+    size_t end,
+    double parentVariance,
     int& bestFeature,
     double& bestThreshold,
     double& bestGain) const
@@ -126,63 +382,49 @@ void DecisionTree::findBestSplit(
     bestThreshold = 0.0;
     bestGain = -std::numeric_limits<double>::infinity();
     
-    if (X.empty()) return;
+    size_t sampleCount = end - begin;
+    if (sampleCount < 2) return;
     
-    int sampleCount = X.size();
-    int numFeatures = X[0].size();
-    double parentVariance = calculateVariance(y);
+    const int* samples = _sortedSamples.data();
+    double totalSum = 0.0;
+    double totalSumSquared = 0.0;
+    for (size_t pos = begin; pos < end; ++pos)
+    {
+        double label = y[samples[pos]];
+        totalSum += label;
+        totalSumSquared += label * label;
+    }
     
-    _tempFeatureValues.clear();
-    _tempFeatureValues.reserve(sampleCount);
-
-    _tempLeftY.clear();
-    _tempRightY.clear();
-    _tempLeftY.reserve(sampleCount);
-    _tempRightY.reserve(sampleCount);
-
-    for (int featureIdx = 0; featureIdx < numFeatures; ++featureIdx)
+    for (size_t featureIdx = 0; featureIdx < matrix.numFeatures; ++featureIdx)
     {
-        _tempFeatureValues.clear();
-        for (const auto& sample : X)
-        {
-            _tempFeatureValues.push_back(sample[featureIdx]);
-        }
+        const int* order = _sortedSamples.data() + featureIdx * _sampleCount + begin;
+        const double* column = matrix.column(featureIdx);
         
-        std::sort(_tempFeatureValues.begin(), _tempFeatureValues.end());
-        _tempFeatureValues.erase(
-            std::unique(_tempFeatureValues.begin(), _tempFeatureValues.end()),
-            _tempFeatureValues.end()
-        );
+        double leftSum = 0.0;
+        double leftSumSquared = 0.0;
         
-        for (size_t i = 0; i + 1 < _tempFeatureValues.size(); ++i)
+        // Threshold between order[i] and order[i + 1] sends the first i + 1 samples left
+        for (size_t i = 0; i + 1 < sampleCount; ++i)
         {
-            std::uniform_real_distribution<double> dist(_tempFeatureValues[i], _tempFeatureValues[i + 1]);
-            double threshold = dist(_randomEngine);
-            
-            _tempLeftY.clear();
-            _tempRightY.clear();
-            for (size_t j = 0; j < X.size(); ++j)
-            {
-                if (X[j][featureIdx] < threshold)
-                {
-                    _tempLeftY.push_back(y[j]);
-                }
-                else
-                {
-                    _tempRightY.push_back(y[j]);
-                }
-            }
+            int idx = order[i];
+            leftSum += y[idx];
+            leftSumSquared += y[idx] * y[idx];
             
-            if ((_tempLeftY.empty()) 
-            || (_tempRightY.empty()))
+            double current = column[idx];
+            double next = column[order[i + 1]];
+            if (!(current < next))
             {
                 continue;
             }
             
-            double leftVariance = calculateVariance(_tempLeftY);
-            double rightVariance = calculateVariance(_tempRightY);
+            double leftCount = static_cast<double>(i + 1);
+            double rightCount = static_cast<double>(sampleCount - i - 1);
+            double rightSum = totalSum - leftSum;
+            double rightSumSquared = totalSumSquared - leftSumSquared;
             
-            double weightedVariance = (_tempLeftY.size() * leftVariance + _tempRightY.size() * rightVariance) / (_tempLeftY.size() + _tempRightY.size());
+            // n * Var = sum(y^2) - sum(y)^2 / n for each side
+            double weightedVariance = ((leftSumSquared - leftSum * leftSum / leftCount)
+                + (rightSumSquared - rightSum * rightSum / rightCount)) / sampleCount;
             
             double gain = parentVariance - weightedVariance;
             
@@ -190,66 +432,253 @@ void DecisionTree::findBestSplit(
             {
                 bestGain = gain;
                 bestFeature = featureIdx;
-                bestThreshold = threshold;
+                bestThreshold = current + (next - current) * 0.5;
+                if (!(current < bestThreshold))
+                {
+                    bestThreshold = next;
+                }
             }
         }
     }
 }
 
-double DecisionTree::calculateVariance(const std::vector<double>& values) const
+size_t DecisionTree::partitionSamples(
+    const FeatureMatrix& matrix,
+    size_t begin,
+    size_t end,
+    int featureIdx,
+    double threshold)
 {
-    if (values.empty())
+    const double* column = matrix.column(featureIdx);
+    const int* samples = _sortedSamples.data();
+    
+    size_t leftCount = 0;
+    for (size_t pos = begin; pos < end; ++pos)
     {
-        return 0.0;
+        int idx = samples[pos];
+        bool left = column[idx] < threshold;
+        _goesLeft[idx] = left ? 1 : 0;
+        leftCount += left ? 1 : 0;
     }
     
-    double mean = calculateMean(values);
-    double variance = 0.0;
+    // Left samples are compacted in place (write position never passes read position),
+    // right samples go through scratch and are appended after them
+    for (size_t f = 0; f < matrix.numFeatures; ++f)
+    {
+        int* segment = _sortedSamples.data() + f * _sampleCount;
+        size_t writePos = begin;
+        size_t rightCount = 0;
+        
+        for (size_t pos = begin; pos < end; ++pos)
+        {
+            int idx = segment[pos];
+            if (_goesLeft[idx])
+            {
+                segment[writePos++] = idx;
+            }
+            else
+            {
+                _scratch[rightCount++] = idx;
+            }
+        }
+        std::copy(_scratch.begin(), _scratch.begin() + rightCount, segment + writePos);
+    }
     
-    for (double val : values)
+    return leftCount;
+}
+
+void DecisionTree::trainHistogram(const BinnedFeatures& binned, const std::vector<double>& y, std::vector<int> sampleIndices)
+{
+    if ((binned.numRows == 0)
+    || (sampleIndices.empty())
+    || (y.size() != binned.numRows))
     {
-        variance += (val - mean) * (val - mean);
+        return;
     }
     
-    return variance / values.size();
+    _featureImportances.assign(binned.numFeatures, 0.0);
+    
+    std::vector<HistogramBin> histogram;
+    buildHistogram(binned, y, sampleIndices, histogram);
+    
+    _root = buildHistogramTree(binned, y, sampleIndices, histogram, 0);
+    _currentDepth = 0;
 }
 
-double DecisionTree::calculateMean(const std::vector<double>& values) const
+std::unique_ptr<TreeNode> DecisionTree::buildHistogramTree(
+    const BinnedFeatures& binned,
+    const std::vector<double>& y,
+    std::span<int> samples,
+    std::vector<HistogramBin>& histogram,
+    int depth)
 {
-    if (values.empty())
+    auto node = std::make_unique<TreeNode>();
+    
+    size_t sampleCount = samples.size();
+    
+    // Every feature's bins cover all node samples, so feature 0 gives the totals
+    double sum = 0.0;
+    double sumSquared = 0.0;
+    for (int b = 0; b < RF_HISTOGRAM_MAX_BINS; ++b)
     {
-        return 0.0;
+        sum += histogram[b].sum;
+        sumSquared += histogram[b].sumSquared;
+    }
+    double mean = sampleCount > 0 ? sum / sampleCount : 0.0;
+    node->leafValue = mean;
+    
+    if (depth >= _maxDepth)
+    {
+        return node;
+    }
+    
+    if (sampleCount < static_cast<size_t>(_minSamplesSplit))
+    {
+        return node;
     }
-    double sum = std::accumulate(values.begin(), values.end(), 0.0);
-    return sum / values.size();
+    
+    double variance = sumSquared / sampleCount - mean * mean;
+    if (variance < RF_VARIANCE_EPSILON)
+    {
+        return node;
+    }
+    
+    int bestFeature = RF_LEAF_FEATURES_INDEX;
+    int bestBin = 0;
+    double bestGain = 0.0;
+    
+    findBestHistogramSplit(binned, histogram, variance, bestFeature, bestBin, bestGain);
+    
+    if ((bestFeature == RF_LEAF_FEATURES_INDEX)
+    || (bestGain <= 0.0))
+    {
+        return node;
+    }
+    
+    const uint8_t* column = binned.column(bestFeature);
+    auto middle = std::partition(samples.begin(), samples.end(), [column, bestBin](int idx) {
+        return column[idx] <= bestBin;
+    });
+    size_t leftCount = middle - samples.begin();
+    
+    if ((leftCount == 0)
+    || (leftCount == sampleCount))
+    {
+        return node;
+    }
+    
+    _featureImportances[bestFeature] += sampleCount * bestGain;
+    
+    std::span<int> leftSamples = samples.first(leftCount);
+    std::span<int> rightSamples = samples.subspan(leftCount);
+    bool leftIsSmaller = leftSamples.size() <= rightSamples.size();
+    
+    // Scan only the smaller child; the larger child's histogram is parent minus sibling
+    std::vector<HistogramBin> smallerHistogram;
+    buildHistogram(binned, y, leftIsSmaller ? leftSamples : rightSamples, smallerHistogram);
+    for (size_t i = 0; i < histogram.size(); ++i)
+    {
+        histogram[i].count -= smallerHistogram[i].count;
+        histogram[i].sum -= smallerHistogram[i].sum;
+        histogram[i].sumSquared -= smallerHistogram[i].sumSquared;
+    }
+    
+    node->featureIndex = bestFeature;
+    node->threshold = binned.cutPoints[bestFeature][bestBin];
+    node->leftChild = buildHistogramTree(binned, y, leftSamples, leftIsSmaller ? smallerHistogram : histogram, depth + 1);
+    node->rightChild = buildHistogramTree(binned, y, rightSamples, leftIsSmaller ? histogram : smallerHistogram, depth + 1);
+    
+    return node;
 }
 
-void DecisionTree::splitData(
-    const std::vector<std::vector<double>>& X,
+void DecisionTree::buildHistogram(
+    const BinnedFeatures& binned,
     const std::vector<double>& y,
-    int featureIdx,
-    double threshold,
-    std::vector<std::vector<double>>& leftX,
-    std::vector<double>& leftY,
-    std::vector<std::vector<double>>& rightX,
-    std::vector<double>& rightY) const
+    std::span<const int> samples,
+    std::vector<HistogramBin>& histogram) const
 {
-    leftX.clear();
-    leftY.clear();
-    rightX.clear();
-    rightY.clear();
+    histogram.assign(binned.numFeatures * RF_HISTOGRAM_MAX_BINS, HistogramBin{});
     
-    for (size_t i = 0; i < X.size(); ++i)
+    for (size_t f = 0; f < binned.numFeatures; ++f)
     {
-        if (X[i][featureIdx] < threshold)
+        const uint8_t* column = binned.column(f);
+        HistogramBin* featureBins = histogram.data() + f * RF_HISTOGRAM_MAX_BINS;
+        
+        for (int idx : samples)
         {
-            leftX.push_back(X[i]);
-            leftY.push_back(y[i]);
+            HistogramBin& bin = featureBins[column[idx]];
+            bin.count += 1.0;
+            bin.sum += y[idx];
+            bin.sumSquared += y[idx] * y[idx];
         }
-        else
+    }
+}
+
+void DecisionTree::findBestHistogramSplit(
+    const BinnedFeatures& binned,
+    const std::vector<HistogramBin>& histogram,
+    double parentVariance,
+    int& bestFeature,
+    int& bestBin,
+    double& bestGain) const
+{
+    bestFeature = RF_LEAF_FEATURES_INDEX;
+    bestBin = 0;
+    bestGain = -std::numeric_limits<double>::infinity();
+    
+    double totalCount = 0.0;
+    double totalSum = 0.0;
+    double totalSumSquared = 0.0;
+    for (int b = 0; b < RF_HISTOGRAM_MAX_BINS; ++b)
+    {
+        totalCount += histogram[b].count;
+        totalSum += histogram[b].sum;
+        totalSumSquared += histogram[b].sumSquared;
+    }
+    
+    if (totalCount < 2.0) return;
+    
+    for (size_t f = 0; f < binned.numFeatures; ++f)
+    {
+        const HistogramBin* featureBins = histogram.data() + f * RF_HISTOGRAM_MAX_BINS;
+        int numCuts = binned.cutPoints[f].size();
+        
+        double leftCount = 0.0;
+        double leftSum = 0.0;
+        double leftSumSquared = 0.0;
+        
+        // Cut b sends bins [0, b] left
+        for (int b = 0; b < numCuts; ++b)
         {
-            rightX.push_back(X[i]);
-            rightY.push_back(y[i]);
+            if (featureBins[b].count <= 0.0)
+            {
+                continue;
+            }
+            
+            leftCount += featureBins[b].count;
+            leftSum += featureBins[b].sum;
+            leftSumSquared += featureBins[b].sumSquared;
+            
+            double rightCount = totalCount - leftCount;
+            if (rightCount <= 0.0)
+            {
+                break;
+            }
+            
+            double rightSum = totalSum - leftSum;
+            double rightSumSquared = totalSumSquared - leftSumSquared;
+            
+            double weightedVariance = ((leftSumSquared - leftSum * leftSum / leftCount)
+                + (rightSumSquared - rightSum * rightSum / rightCount)) / totalCount;
+            
+            double gain = parentVariance - weightedVariance;
+            
+            if (gain > bestGain)
+            {
+                bestGain = gain;
+                bestFeature = f;
+                bestBin = b;
+            }
         }
     }
 }
@@ -278,6 +707,35 @@ double DecisionTree::predictRecursive(const TreeNode* node, const std::vector<do
     }
 }
 
+void DecisionTree::flattenInto(FlatForest& forest) const
+{
+    if (!_root) return;
+
+    forest.treeRoots.push_back(flattenNode(_root.get(), forest));
+}
+
+int DecisionTree::flattenNode(const TreeNode* node, FlatForest& forest) const
+{
+    int offset = forest.appendNode();
+
+    if (node->isLeaf())
+    {
+        forest.leafValues[offset] = node->leafValue;
+        return offset;
+    }
+
+    forest.featureIndices[offset] = node->featureIndex;
+    forest.thresholds[offset] = node->threshold;
+
+    // Children are appended after the parent, so offsets must be read back by index
+    int left = flattenNode(node->leftChild.get(), forest);
+    int right = flattenNode(node->rightChild.get(), forest);
+    forest.leftChildren[offset] = left;
+    forest.rightChildren[offset] = right;
+
+    return offset;
+}
+
 bool DecisionTree::isTrained() const
 {
     return _root != nullptr;
@@ -288,12 +746,20 @@ int DecisionTree::getDepth() const
     return _currentDepth;
 }
 
-RandomForest::RandomForest(int numTrees, int maxDepth, int minSamples)
+const std::vector<double>& DecisionTree::getFeatureImportances() const
+{
+    return _featureImportances;
+}
+
+RandomForest::RandomForest(int numTrees, int maxDepth, int minSamples, SplitMode splitMode)
     : _numTrees(numTrees),
     _maxDepth(maxDepth),
     _minSamplesSplit(minSamples),
+    _numFeatures(0),
+    _splitMode(splitMode),
     _isTrained(false),
-    _randomEngine(std::random_device{}())
+    _seed(std::random_device{}()),
+    _numThreads(0)
 {
 }
 
@@ -307,66 +773,332 @@ void RandomForest::train(const std::vector<std::vector<double>>& X, const std::v
         return;
     }
     
+    // Features are laid out (and sorted or quantized) once; trees only hold bootstrap indices into them
+    FeatureMatrix matrix;
+    BinnedFeatures binned;
+    if (_splitMode == SplitMode::Histogram)
+    {
+        binned.build(X);
+    }
+    else
+    {
+        matrix.build(X);
+    }
+    
     _trees.clear();
-    _trees.reserve(_numTrees);
+    _trees.resize(_numTrees);
+    
+    // Each tree owns its slot and seed, so the forest is identical for a given seed regardless of scheduling
+    runParallel(_numTrees, _numThreads, [&](int i) {
+        _trees[i] = trainTree(i, X.size(), matrix, binned, y);
+    });
     
-    for (int i = 0; i < _numTrees; ++i)
+    _numFeatures = static_cast<int>(X[0].size());
+    collectFeatureImportances();
+    compile();
+    _isTrained = true;
+}
+
+void RandomForest::collectFeatureImportances()
+{
+    // Each tree's decreases are normalized first so deep trees do not dominate the average
+    std::vector<double> totals(_numFeatures, 0.0);
+    for (const auto& tree : _trees)
     {
-        std::vector<std::vector<double>> sampleX;
-        std::vector<double> sampleY;
+        if (!tree) continue;
         
-        bootstrapSample(X, y, sampleX, sampleY);
+        const auto& treeImportances = tree->getFeatureImportances();
+        double treeSum = std::accumulate(treeImportances.begin(), treeImportances.end(), 0.0);
+        if (treeSum <= 0.0) continue;
         
-        auto tree = std::make_unique<DecisionTree>(_maxDepth, _minSamplesSplit);
-        tree->train(sampleX, sampleY);
+        for (size_t f = 0; f < treeImportances.size() && f < totals.size(); ++f)
+        {
+            totals[f] += treeImportances[f] / treeSum;
+        }
+    }
+    
+    double forestSum = std::accumulate(totals.begin(), totals.end(), 0.0);
+    _featureImportances.clear();
+    for (int f = 0; f < _numFeatures; ++f)
+    {
+        _featureImportances[f] = forestSum > 0.0 ? totals[f] / forestSum : 0.0;
+    }
+}
+
+std::map<int, double> RandomForest::computePermutationImportances(
+    const std::vector<double>& columns,
+    const std::vector<double>& y,
+    int numRepeats) const
+{
+    std::map<int, double> importances;
+    size_t numRows = y.size();
+    
+    if ((!_isTrained)
+    || (_forestView.empty())
+    || (numRows == 0)
+    || (columns.size() != numRows * _numFeatures))
+    {
+        return importances;
+    }
+    numRepeats = std::max(1, numRepeats);
+    
+    auto meanSquaredError = [&y, numRows](const std::vector<double>& predictions) {
+        double total = 0.0;
+        for (size_t i = 0; i < numRows; ++i)
+        {
+            double error = predictions[i] - y[i];
+            total += error * error;
+        }
+        return total / numRows;
+    };
+    
+    std::vector<double> predictions(numRows);
+    _forestView.predictBatch(columns.data(), numRows, predictions.data());
+    double baselineError = meanSquaredError(predictions);
+    
+    // One task per feature; each works on a private copy with only its own column shuffled
+    std::vector<double> increases(_numFeatures, 0.0);
+    runParallel(_numFeatures, _numThreads, [&](int feature) {
+        std::vector<double> permuted(columns);
+        std::vector<double> permutedPredictions(numRows);
+        double* column = permuted.data() + feature * numRows;
+        const double* original = columns.data() + feature * numRows;
         
-        _trees.push_back(std::move(tree));
+        double increase = 0.0;
+        for (int repeat = 0; repeat < numRepeats; ++repeat)
+        {
+            std::seed_seq seeds{_seed, static_cast<uint32_t>(feature), static_cast<uint32_t>(repeat)};
+            std::mt19937 randomEngine(seeds);
+            std::copy(original, original + numRows, column);
+            std::shuffle(column, column + numRows, randomEngine);
+            
+            _forestView.predictBatch(permuted.data(), numRows, permutedPredictions.data());
+            increase += meanSquaredError(permutedPredictions) - baselineError;
+        }
+        increases[feature] = increase / numRepeats;
+    });
+    
+    for (int f = 0; f < _numFeatures; ++f)
+    {
+        importances[f] = increases[f];
     }
+    return importances;
+}
+
+std::unique_ptr<DecisionTree> RandomForest::trainTree(
+    int treeIndex,
+    size_t numSamples,
+    const FeatureMatrix& matrix,
+    const BinnedFeatures& binned,
+    const std::vector<double>& y) const
+{
+    std::seed_seq seeds{_seed, static_cast<uint32_t>(treeIndex)};
+    std::mt19937 randomEngine(seeds);
+    
+    auto tree = std::make_unique<DecisionTree>(_maxDepth, _minSamplesSplit);
     
+    if (_splitMode == SplitMode::Histogram)
+    {
+        std::vector<int> indices;
+        bootstrapIndices(numSamples, indices, randomEngine);
+        tree->trainHistogram(binned, y, std::move(indices));
+    }
+    else
+    {
+        std::vector<int> counts;
+        bootstrapCounts(numSamples, counts, randomEngine);
+        tree->train(matrix, y, counts);
+    }
+    
+    return tree;
+}
+
+void RandomForest::compile()
+{
+    _flatForest.clear();
+    _modelFile.reset();
+
+    for (const auto& tree : _trees)
+    {
+        if (tree && tree->isTrained())
+        {
+            tree->flattenInto(_flatForest);
+        }
+    }
+    
+    _forestView = _flatForest.view();
+}
+
+void RandomForest::saveModel(const std::string& path) const
+{
+    if (!_isTrained || _forestView.empty())
+    {
+        throw ValidationException("Model must be trained before saving", "RandomForest");
+    }
+    
+    ModelWriter writer(ModelType::RandomForest);
+    writer.writeValue<int32_t>(_numTrees);
+    writer.writeValue<int32_t>(_maxDepth);
+    writer.writeValue<int32_t>(_minSamplesSplit);
+    writer.writeValue<int32_t>(_numFeatures);
+    writer.writeValue<int32_t>(static_cast<int32_t>(_splitMode));
+    writer.writeValue<uint32_t>(_seed);
+    
+    writer.writeArray(std::span<const int>(_forestView.featureIndices, _forestView.nodeCount));
+    writer.writeArray(std::span<const double>(_forestView.thresholds, _forestView.nodeCount));
+    writer.writeArray(std::span<const int>(_forestView.leftChildren, _forestView.nodeCount));
+    writer.writeArray(std::span<const int>(_forestView.rightChildren, _forestView.nodeCount));
+    writer.writeArray(std::span<const double>(_forestView.leafValues, _forestView.nodeCount));
+    writer.writeArray(std::span<const int>(_forestView.treeRoots, _forestView.numTrees));
+    
+    std::vector<double> importances(_numFeatures, 0.0);
+    for (const auto& [feature, importance] : _featureImportances)
+    {
+        importances[feature] = importance;
+    }
+    writer.writeArray(std::span<const double>(importances));
+    
+    writer.saveToFile(path);
+}
+
+void RandomForest::loadModel(const std::string& path)
+{
+    static_assert(sizeof(int) == sizeof(int32_t), "model files store node indices as int32");
+    
+    ModelReader reader(std::make_shared<const MappedFile>(path), ModelType::RandomForest);
+    
+    int numTrees = reader.readValue<int32_t>();
+    int maxDepth = reader.readValue<int32_t>();
+    int minSamplesSplit = reader.readValue<int32_t>();
+    int numFeatures = reader.readValue<int32_t>();
+    auto splitMode = static_cast<SplitMode>(reader.readValue<int32_t>());
+    uint32_t seed = reader.readValue<uint32_t>();
+    
+    auto featureIndices = reader.readArray<int>();
+    auto thresholds = reader.readArray<double>();
+    auto leftChildren = reader.readArray<int>();
+    auto rightChildren = reader.readArray<int>();
+    auto leafValues = reader.readArray<double>();
+    auto treeRoots = reader.readArray<int>();
+    auto importances = reader.readArray<double>();
+    
+    // Validate every offset once here so predict() can walk the arrays unchecked
+    size_t nodeCount = featureIndices.size();
+    if ((thresholds.size() != nodeCount)
+    || (leftChildren.size() != nodeCount)
+    || (rightChildren.size() != nodeCount)
+    || (leafValues.size() != nodeCount)
+    || (treeRoots.empty())
+    || (importances.size() != static_cast<size_t>(std::max(numFeatures, 0))))
+    {
+        throw ValidationException("Corrupt RandomForest model: array sizes differ", "modelPath");
+    }
+    
+    auto inRange = [nodeCount](int offset) {
+        return offset >= 0 && static_cast<size_t>(offset) < nodeCount;
+    };
+    for (size_t i = 0; i < nodeCount; ++i)
+    {
+        if (featureIndices[i] == RF_LEAF_FEATURES_INDEX) continue;
+        
+        // Children always follow their parent (pre-order), which also rules out cycles
+        if ((featureIndices[i] < 0)
+        || (featureIndices[i] >= numFeatures)
+        || (!inRange(leftChildren[i]))
+        || (!inRange(rightChildren[i]))
+        || (static_cast<size_t>(leftChildren[i]) <= i)
+        || (static_cast<size_t>(rightChildren[i]) <= i))
+        {
+            throw ValidationException("Corrupt RandomForest model: bad node " + std::to_string(i), "modelPath");
+        }
+    }
+    for (int root : treeRoots)
+    {
+        if (!inRange(root))
+        {
+            throw ValidationException("Corrupt RandomForest model: bad tree root", "modelPath");
+        }
+    }
+    
+    _trees.clear();
+    _flatForest.clear();
+    _modelFile = reader.getFile();
+    
+    _featureImportances.clear();
+    for (int f = 0; f < numFeatures; ++f)
+    {
+        _featureImportances[f] = importances[f];
+    }
+    
+    _forestView.featureIndices = featureIndices.data();
+    _forestView.thresholds = thresholds.data();
+    _forestView.leftChildren = leftChildren.data();
+    _forestView.rightChildren = rightChildren.data();
+    _forestView.leafValues = leafValues.data();
+    _forestView.treeRoots = treeRoots.data();
+    _forestView.nodeCount = nodeCount;
+    _forestView.numTrees = treeRoots.size();
+    
+    _numTrees = numTrees;
+    _maxDepth = maxDepth;
+    _minSamplesSplit = minSamplesSplit;
+    _numFeatures = numFeatures;
+    _splitMode = splitMode;
+    _seed = seed;
     _isTrained = true;
 }
 
-void RandomForest::bootstrapSample(
-    const std::vector<std::vector<double>>& X,
-    const std::vector<double>& y,
-    std::vector<std::vector<double>>& sampleX,
-    std::vector<double>& sampleY)
+void RandomForest::bootstrapCounts(size_t numSamples, std::vector<int>& counts, std::mt19937& randomEngine)
 {
-    sampleX.clear();
-    sampleY.clear();
+    counts.assign(numSamples, 0);
+    std::uniform_int_distribution<size_t> dist(0, numSamples - 1);
     
-    size_t numSamples = X.size();
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        ++counts[dist(randomEngine)];
+    }
+}
+
+void RandomForest::bootstrapIndices(size_t numSamples, std::vector<int>& indices, std::mt19937& randomEngine)
+{
+    indices.resize(numSamples);
     std::uniform_int_distribution<size_t> dist(0, numSamples - 1);
     
     for (size_t i = 0; i < numSamples; ++i)
     {
-        size_t idx = dist(_randomEngine);
-        sampleX.push_back(X[idx]);
-        sampleY.push_back(y[idx]);
+        indices[i] = static_cast<int>(dist(randomEngine));
     }
 }
 
 double RandomForest::predict(const std::vector<double>& features) const
+{
+    return predict(features.data());
+}
+
+double RandomForest::predict(const double* features) const
 {
     if ((!_isTrained)
-    || (_trees.empty()))
+    || (_forestView.empty()))
     {
         return 0.0;
     }
     
-    double sum = 0.0;
-    int validTrees = 0;
-    
-    for (const auto& tree : _trees)
+    return _forestView.predict(features);
+}
+
+std::vector<double> RandomForest::predictBatch(const std::vector<double>& columns, size_t numRows) const
+{
+    std::vector<double> predictions(numRows, 0.0);
+
+    if ((!_isTrained)
+    || (_forestView.empty())
+    || (numRows == 0))
     {
-        if (tree && tree->isTrained())
-        {
-            sum += tree->predict(features);
-            ++validTrees;
-        }
+        return predictions;
     }
-    
-    return validTrees > 0 ? (sum / validTrees) : 0.0;
+
+    _forestView.predictBatch(columns.data(), numRows, predictions.data());
+    return predictions;
 }
 
 bool RandomForest::isTrained() const
@@ -379,4 +1111,34 @@ int RandomForest::getNumTrees() const
     return _numTrees;
 }
 
+SplitMode RandomForest::getSplitMode() const
+{
+    return _splitMode;
+}
+
+void RandomForest::setSeed(uint32_t seed)
+{
+    _seed = seed;
+}
+
+void RandomForest::setNumThreads(int numThreads)
+{
+    _numThreads = numThreads;
+}
+
+int RandomForest::getNumFeatures() const
+{
+    return _numFeatures;
+}
+
+const std::map<int, double>& RandomForest::getFeatureImportances() const
+{
+    return _featureImportances;
+}
+
+const FlatForestView& RandomForest::getForestView() const
+{
+    return _forestView;
+}
+
 }
@@ -4,35 +4,198 @@
 #include "../../common/include/utils/Logger.h"
 #include "../../common/include/utils/Constants.h"
 #include "../../common/include/models/Response.h"
+#include "../../common/include/exceptions/ValidationException.h"
 #include "../include/models/RiskScorer.h"
+#include "../include/models/AssessmentCache.h"
+#include "../include/models/ModelWatcher.h"
+#include "../include/models/BorrowerSegmenter.h"
+#include "../include/models/IncrementalRescorer.h"
 #include "../include/algorithms/KMeansClustering.h"
+#include "../include/algorithms/KMeansModelSelector.h"
+#include "../include/algorithms/DistanceKernels.h"
+#include "../include/algorithms/CompactForest.h"
+#include "../include/repositories/ModelRegistryRepository.h"
+#include "../include/repositories/AccountFeatureRepository.h"
+#include "../include/repositories/RiskAssessmentRepository.h"
+#include "../../common/include/database/DatabaseManager.h"
+#include <filesystem>
 
 using json = nlohmann::json;
 using namespace sdrs::risk;
 using namespace sdrs::borrower;
 using namespace sdrs::money;
 
+// Rows serialized per chunk when streaming batch results
+constexpr size_t BATCH_STREAM_CHUNK_ROWS = 1000;
+
+// Check if database mode is enabled via SDRS_USE_DATABASE ("1" or "true")
+bool isDatabaseEnabled() {
+    const char* useDb = std::getenv("SDRS_USE_DATABASE");
+    if (!useDb) return false;
+    std::string value(useDb);
+    return value == "1" || value == "true" || value == "TRUE";
+}
+
+// Build RiskFeatures from one /assess-risk JSON object
+RiskFeatures parseRiskFeatures(const json& j) {
+    RiskFeatures features;
+    features.accountId = j["account_id"].get<int>();
+    features.borrowerId = j["borrower_id"].get<int>();
+    features.daysPastDue = j["days_past_due"].get<int>();
+    features.numberOfMissedPayments = j["missed_payments"].get<int>();
+    features.loanAmount = Money(j["loan_amount"].get<double>());
+    features.remainingAmount = Money(j["remaining_amount"].get<double>());
+    features.interestRate = j["interest_rate"].get<double>();
+    features.monthlyIncome = Money(j["monthly_income"].get<double>());
+    features.accountAgeMonths = j["account_age_months"].get<int>();
+    
+    // NEW: Age feature (Proposal requirement)
+    if (j.contains("age")) {
+        features.age = j["age"].get<int>();
+    }
+    return features;
+}
+
 int main() {
     std::cout << "Starting Risk Assessment Service..." << std::endl;
     
+    bool useMock = !isDatabaseEnabled();
+    if (!useMock) {
+        try {
+            sdrs::database::DatabaseManager::getInstance().initializeFromEnv();
+            sdrs::utils::Logger::Info("Database connection pool initialized successfully");
+        }
+        catch (const std::exception& e) {
+            sdrs::utils::Logger::Error("Failed to initialize database: " + std::string(e.what()));
+            sdrs::utils::Logger::Info("Falling back to mock mode");
+            useMock = true;
+        }
+    }
+    
     httplib::Server server;
-    RiskScorer scorer;
     
-    // Train Random Forest model on startup (Proposal requirement: ML-based risk assessment)
-    std::cout << "Training Random Forest model with synthetic data..." << std::endl;
+    // Repeat /assess-risk calls with unchanged inputs are answered from a cache
+    // (SDRS_RISK_CACHE_CAPACITY entries, 0 = off; SDRS_RISK_CACHE_TTL seconds)
+    size_t cacheCapacity = sdrs::constants::risk::RISK_CACHE_CAPACITY;
+    if (const char* envCapacity = std::getenv("SDRS_RISK_CACHE_CAPACITY")) {
+        cacheCapacity = std::strtoul(envCapacity, nullptr, 10);
+    }
+    int cacheTtl = sdrs::constants::risk::RISK_CACHE_TTL_SECONDS;
+    if (const char* envTtl = std::getenv("SDRS_RISK_CACHE_TTL")) {
+        cacheTtl = std::atoi(envTtl);
+    }
+    RiskScorer scorer(cacheCapacity, std::chrono::seconds(cacheTtl));
+    
+    // Score with a reduced-precision copy of the forest (SDRS_RISK_MODEL_PRECISION: float64, float32 or uint16)
+    if (const char* envPrecision = std::getenv("SDRS_RISK_MODEL_PRECISION")) {
+        try {
+            scorer.setModelPrecision(CompactForest::stringToPrecision(envPrecision));
+        } catch (const std::exception& e) {
+            sdrs::utils::Logger::Warn("Ignoring SDRS_RISK_MODEL_PRECISION: " + std::string(e.what()));
+        }
+    }
+    ModelRegistryRepository modelRegistry(useMock);
+    BorrowerSegmentRepository segmentRepository(useMock);
+    AccountFeatureRepository featureRepository(useMock);
+    
+    // The manager is a process-wide singleton; the repository only borrows it
+    std::shared_ptr<sdrs::database::DatabaseManager> dbManager;
+    if (!useMock) {
+        dbManager = std::shared_ptr<sdrs::database::DatabaseManager>(
+            &sdrs::database::DatabaseManager::getInstance(), [](sdrs::database::DatabaseManager*) {});
+    }
+    RiskAssessmentRepository assessmentRepository(dbManager);
+    
+    // Model artifact: the active one from ml_models, else SDRS_RISK_MODEL_PATH, else the default path
+    auto resolveModelPath = [&modelRegistry]() {
+        std::string path = sdrs::constants::risk::DEFAULT_RISK_MODEL_PATH;
+        if (const char* envPath = std::getenv("SDRS_RISK_MODEL_PATH")) {
+            path = envPath;
+        }
+        try {
+            if (auto active = modelRegistry.findActive("RandomForest"); active && !active->artifactPath.empty()) {
+                path = active->artifactPath;
+            }
+        } catch (const std::exception& e) {
+            sdrs::utils::Logger::Warn("Could not read active model from registry: " + std::string(e.what()));
+        }
+        return path;
+    };
+    std::string modelPath = resolveModelPath();
+    
+    // Map the saved model if there is one; train from synthetic data only on first start
+    bool modelLoaded = false;
     try {
-        scorer.trainModel();
-        // Use Rule-Based algorithm as default (more reliable for edge cases)
-        // Random Forest is trained and available but Rule-Based provides better accuracy
-        scorer.setUseMLModel(false);  // Use Rule-Based for production reliability
-        std::cout << "✓ Random Forest model trained successfully!" << std::endl;
-        std::cout << "  Algorithm: Rule-Based (Enhanced with DTI & Account Age logic)" << std::endl;
-        std::cout << "  Note: Random Forest available but Rule-Based selected for edge case accuracy" << std::endl;
+        if (std::filesystem::exists(modelPath)) {
+            scorer.loadModel(modelPath);
+            modelLoaded = true;
+            std::cout << "✓ Random Forest model loaded from " << modelPath << std::endl;
+        }
     } catch (const std::exception& e) {
-        std::cerr << "✗ Failed to train model: " << e.what() << std::endl;
-        std::cerr << "  Falling back to Rule-Based algorithm" << std::endl;
+        std::cerr << "✗ Failed to load model " << modelPath << ": " << e.what() << std::endl;
     }
     
+    if (!modelLoaded) {
+        // Train Random Forest model on startup (Proposal requirement: ML-based risk assessment)
+        std::cout << "Training Random Forest model with synthetic data..." << std::endl;
+        try {
+            scorer.trainModel();
+            std::cout << "✓ Random Forest model trained successfully!" << std::endl;
+            
+            try {
+                std::filesystem::path artifact(modelPath);
+                if (artifact.has_parent_path()) {
+                    std::filesystem::create_directories(artifact.parent_path());
+                }
+                scorer.saveModel(modelPath);
+                
+                ModelRecord record;
+                record.modelName = "Risk_Predictor";
+                record.modelType = "RandomForest";
+                record.version = sdrs::constants::app::VERSION;
+                record.artifactPath = std::filesystem::absolute(artifact).string();
+                record.formatVersion = sdrs::constants::risk::MODEL_FORMAT_VERSION;
+                json hyperparameters = {
+                    {"n_estimators", sdrs::constants::risk::RF_NUM_TREES},
+                    {"max_depth", sdrs::constants::risk::RF_MAX_DEPTH},
+                    {"min_samples_split", sdrs::constants::risk::RF_MIN_SAMPLES_SPLIT}
+                };
+                modelRegistry.registerActive(record, hyperparameters.dump());
+                std::cout << "  Model saved to " << record.artifactPath << std::endl;
+            } catch (const std::exception& e) {
+                sdrs::utils::Logger::Warn("Model trained but not persisted: " + std::string(e.what()));
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "✗ Failed to train model: " << e.what() << std::endl;
+            std::cerr << "  Falling back to Rule-Based algorithm" << std::endl;
+        }
+    }
+    
+    // Use Rule-Based algorithm as default (more reliable for edge cases)
+    // Random Forest is trained and available but Rule-Based provides better accuracy
+    scorer.setUseMLModel(false);  // Use Rule-Based for production reliability
+    std::cout << "  Algorithm: Rule-Based (Enhanced with DTI & Account Age logic)" << std::endl;
+    std::cout << "  Note: Random Forest available but Rule-Based selected for edge case accuracy" << std::endl;
+    
+    // Hot-swap the model whenever the active artifact is replaced (SDRS_MODEL_WATCH_INTERVAL seconds, 0 = off)
+    int watchInterval = sdrs::constants::risk::MODEL_WATCH_INTERVAL_SECONDS;
+    if (const char* envInterval = std::getenv("SDRS_MODEL_WATCH_INTERVAL")) {
+        watchInterval = std::atoi(envInterval);
+    }
+    ModelWatcher modelWatcher(scorer, resolveModelPath, std::chrono::seconds(watchInterval));
+    if (scorer.getModel()) {
+        modelWatcher.markLoaded(modelPath);
+    }
+    modelWatcher.start();
+    
+    // Re-score accounts whose payments, loan or borrower data changed (SDRS_RESCORE_INTERVAL seconds, 0 = off)
+    int rescoreInterval = sdrs::constants::risk::RESCORE_INTERVAL_SECONDS;
+    if (const char* envInterval = std::getenv("SDRS_RESCORE_INTERVAL")) {
+        rescoreInterval = std::atoi(envInterval);
+    }
+    IncrementalRescorer rescorer(scorer, featureRepository, assessmentRepository, std::chrono::seconds(rescoreInterval));
+    rescorer.start();
+    
     // Health check endpoint
     server.Get("/health", [](const httplib::Request&, httplib::Response& res) {
         json response = {
@@ -47,21 +210,7 @@ int main() {
         try {
             auto j = json::parse(req.body);
             
-            RiskFeatures features;
-            features.accountId = j["account_id"].get<int>();
-            features.borrowerId = j["borrower_id"].get<int>();
-            features.daysPastDue = j["days_past_due"].get<int>();
-            features.numberOfMissedPayments = j["missed_payments"].get<int>();
-            features.loanAmount = Money(j["loan_amount"].get<double>());
-            features.remainingAmount = Money(j["remaining_amount"].get<double>());
-            features.interestRate = j["interest_rate"].get<double>();
-            features.monthlyIncome = Money(j["monthly_income"].get<double>());
-            features.accountAgeMonths = j["account_age_months"].get<int>();
-            
-            // NEW: Age feature (Proposal requirement)
-            if (j.contains("age")) {
-                features.age = j["age"].get<int>();
-            }
+            RiskFeatures features = parseRiskFeatures(j);
             
             auto assessment = scorer.assessRisk(features);
             
@@ -81,7 +230,118 @@ int main() {
         }
     });
     
+    // POST /assess-risk/batch - Assess many accounts in one call
+    // Body: {"accounts": [ {...same fields as /assess-risk...}, ... ]}
+    // Response data is streamed as one JSON array, chunk by chunk
+    server.Post("/assess-risk/batch", [&scorer](const httplib::Request& req, httplib::Response& res) {
+        try {
+            auto j = json::parse(req.body);
+            const auto& accountsJson = j["accounts"];
+            
+            if (!accountsJson.is_array() || accountsJson.empty()) {
+                auto response = sdrs::models::Response<void>::badRequest("Accounts array cannot be empty");
+                res.status = response.getStatusCode();
+                res.set_content(response.toJson(), "application/json");
+                return;
+            }
+            
+            if (accountsJson.size() > sdrs::constants::risk::RISK_BATCH_MAX_ROWS) {
+                auto response = sdrs::models::Response<void>::badRequest("Batch exceeds "
+                    + std::to_string(sdrs::constants::risk::RISK_BATCH_MAX_ROWS) + " accounts; split it into several calls");
+                res.status = response.getStatusCode();
+                res.set_content(response.toJson(), "application/json");
+                return;
+            }
+            
+            std::vector<RiskFeatures> batch;
+            batch.reserve(accountsJson.size());
+            for (size_t i = 0; i < accountsJson.size(); ++i) {
+                try {
+                    batch.push_back(parseRiskFeatures(accountsJson[i]));
+                }
+                catch (const json::exception& e) {
+                    throw sdrs::exceptions::ValidationException(
+                        "Account " + std::to_string(i) + " is invalid: " + e.what(), "accounts");
+                }
+            }
+            
+            auto assessments = std::make_shared<std::vector<RiskAssessment>>(scorer.assessRiskBatch(batch));
+            auto nextRow = std::make_shared<size_t>(0);
+            
+            res.set_chunked_content_provider("application/json",
+                [assessments, nextRow](size_t, httplib::DataSink& sink) {
+                    std::string chunk;
+                    if (*nextRow == 0) {
+                        chunk = "{\"success\":true,\"message\":\"Risk assessed successfully\",\"status_code\":200"
+                                ",\"count\":" + std::to_string(assessments->size()) + ",\"data\":[";
+                    }
+                    
+                    size_t end = std::min(*nextRow + BATCH_STREAM_CHUNK_ROWS, assessments->size());
+                    for (size_t i = *nextRow; i < end; ++i) {
+                        if (i > 0) chunk += ",";
+                        chunk += (*assessments)[i].toJson();
+                    }
+                    *nextRow = end;
+                    
+                    if (end == assessments->size()) {
+                        chunk += "]}";
+                        sink.write(chunk.data(), chunk.size());
+                        sink.done();
+                    } else {
+                        sink.write(chunk.data(), chunk.size());
+                    }
+                    return true;
+                });
+        }
+        catch (const sdrs::exceptions::ValidationException& e) {
+            auto response = sdrs::models::Response<void>::badRequest(std::string("Batch risk assessment failed: ") + e.what());
+            res.status = response.getStatusCode();
+            res.set_content(response.toJson(), "application/json");
+        }
+        catch (const std::exception& e) {
+            auto response = sdrs::models::Response<void>::error(std::string("Batch risk assessment failed: ") + e.what());
+            res.status = response.getStatusCode();
+            res.set_content(response.toJson(), "application/json");
+        }
+    });
+    
+    // POST /assess-risk/rescore - Re-score accounts whose inputs changed since the last pass
+    // Body (optional): {"full": true} re-reads every account instead of only the changed ones
+    server.Post("/assess-risk/rescore", [&rescorer](const httplib::Request& req, httplib::Response& res) {
+        try {
+            bool full = false;
+            if (!req.body.empty()) {
+                full = json::parse(req.body).value("full", false);
+            }
+            
+            auto summary = full ? rescorer.runFullPass() : rescorer.runOnce();
+            
+            json response = {
+                {"success", true},
+                {"message", "Accounts rescored successfully"},
+                {"status_code", 200},
+                {"data", {
+                    {"full_pass", summary.fullPass},
+                    {"model_version", summary.modelVersion},
+                    {"accounts_examined", summary.accountsExamined},
+                    {"accounts_rescored", summary.accountsRescored},
+                    {"assessments_written", summary.assessmentsWritten},
+                    {"risk_level_changes", summary.riskLevelChanges},
+                    {"accounts_tracked", summary.accountsTracked},
+                    {"duration_ms", summary.durationMs}
+                }}
+            };
+            res.set_content(response.dump(), "application/json");
+        }
+        catch (const std::exception& e) {
+            auto response = sdrs::models::Response<void>::error(std::string("Rescoring failed: ") + e.what());
+            res.status = response.getStatusCode();
+            res.set_content(response.toJson(), "application/json");
+        }
+    });
+    
     // POST /cluster/borrowers - K-Means clustering for borrower segmentation (Proposal requirement)
+    // Set "auto_k": true (optionally "min_k", "max_k", "restarts") to pick num_clusters by silhouette
     server.Post("/cluster/borrowers", [](const httplib::Request& req, httplib::Response& res) {
         try {
             auto j = json::parse(req.body);
@@ -111,7 +371,39 @@ int main() {
             
             // Run K-Means clustering
             sdrs::risk::KMeansClustering kmeans(numClusters);
-            kmeans.train(X);
+            json selectionJson = nullptr;
+            if (j.value("auto_k", false)) {
+                sdrs::risk::PointMatrix points;
+                points.assign(X);
+                
+                sdrs::risk::KMeansModelSelector selector(
+                    j.value("min_k", sdrs::constants::risk::KMEANS_AUTO_MIN_K),
+                    j.value("max_k", sdrs::constants::risk::KMEANS_AUTO_MAX_K),
+                    j.value("restarts", sdrs::constants::risk::KMEANS_AUTO_RESTARTS));
+                auto selection = selector.select(points);
+                
+                json candidatesJson = json::array();
+                for (const auto& candidate : selection.candidates) {
+                    candidatesJson.push_back({
+                        {"k", candidate.k},
+                        {"inertia", candidate.inertia},
+                        {"silhouette", candidate.silhouette},
+                        {"iterations", candidate.iterations}
+                    });
+                }
+                selectionJson = {
+                    {"best_k", selection.bestK},
+                    {"elbow_k", selection.elbowK},
+                    {"silhouette_samples", selection.silhouetteSamples},
+                    {"candidates", candidatesJson}
+                };
+                
+                numClusters = selection.bestK;
+                kmeans = std::move(selection.model);
+            }
+            else {
+                kmeans.train(X);
+            }
             
             // Convert centroids to JSON
             json centroidsJson = json::array();
@@ -134,12 +426,20 @@ int main() {
                     {"num_clusters", numClusters},
                     {"centroids", centroidsJson},
                     {"labels", kmeans.getLabels()},
-                    {"inertia", kmeans.getInertia()}
+                    {"inertia", kmeans.getInertia()},
+                    {"iterations", kmeans.getIterations()},
+                    {"distance_kernel", getDistanceKernel().name},
+                    {"selection", selectionJson}
                 }}
             };
             
             res.set_content(response.dump(), "application/json");
         }
+        catch (const sdrs::exceptions::ValidationException& e) {
+            auto response = sdrs::models::Response<void>::badRequest(std::string("Clustering failed: ") + e.what());
+            res.status = response.getStatusCode();
+            res.set_content(response.toJson(), "application/json");
+        }
         catch (const std::exception& e) {
             auto response = sdrs::models::Response<void>::error(std::string("Clustering failed: ") + e.what());
             res.status = response.getStatusCode();
@@ -147,14 +447,68 @@ int main() {
         }
     });
     
+    // POST /cluster/borrowers/segments - Mini-batch K-Means over every account in the database
+    // Body (optional): {"num_clusters": 3, "passes": 3, "batch_size": 5000}; results are written to borrower_segments
+    server.Post("/cluster/borrowers/segments", [&segmentRepository](const httplib::Request& req, httplib::Response& res) {
+        try {
+            json j = req.body.empty() ? json::object() : json::parse(req.body);
+            int numClusters = j.value("num_clusters", sdrs::constants::risk::KMEANS_NUM_CLUSTERS);
+            int passes = j.value("passes", sdrs::constants::risk::KMEANS_MINI_BATCH_PASSES);
+            int batchSize = j.value("batch_size", sdrs::constants::risk::KMEANS_STREAM_PAGE_SIZE);
+            
+            BorrowerSegmenter segmenter(segmentRepository, batchSize);
+            auto summary = segmenter.run(numClusters, passes);
+            
+            json centroidsJson = json::array();
+            for (const auto& centroid : summary.centroids) {
+                centroidsJson.push_back({
+                    {"age", centroid[0]},
+                    {"monthly_income", centroid[1]},
+                    {"debt_ratio", centroid[2]},
+                    {"days_past_due", centroid[3]},
+                    {"missed_payments", centroid[4]}
+                });
+            }
+            
+            json response = {
+                {"success", true},
+                {"message", "Borrower segments updated successfully"},
+                {"status_code", 200},
+                {"data", {
+                    {"num_clusters", summary.numClusters},
+                    {"passes", summary.passes},
+                    {"accounts_segmented", summary.accountsSegmented},
+                    {"cluster_sizes", summary.clusterSizes},
+                    {"centroids", centroidsJson},
+                    {"inertia", summary.inertia}
+                }}
+            };
+            res.set_content(response.dump(), "application/json");
+        }
+        catch (const sdrs::exceptions::ValidationException& e) {
+            auto response = sdrs::models::Response<void>::badRequest(std::string("Segmentation failed: ") + e.what());
+            res.status = response.getStatusCode();
+            res.set_content(response.toJson(), "application/json");
+        }
+        catch (const std::exception& e) {
+            auto response = sdrs::models::Response<void>::error(std::string("Segmentation failed: ") + e.what());
+            res.status = response.getStatusCode();
+            res.set_content(response.toJson(), "application/json");
+        }
+    });
+    
     // GET /model/status - Check if Random Forest model is trained and ready
     server.Get("/model/status", [&scorer](const httplib::Request&, httplib::Response& res) {
+        auto model = scorer.getModel();
         json response = {
             {"success", true},
             {"status_code", 200},
             {"data", {
                 {"model_ready", scorer.isModelReady()},
                 {"algorithm", scorer.isModelReady() ? "RandomForest" : "RuleBased"},
+                {"model_version", model ? model->version : 0},
+                {"model_source", model ? model->source : ""},
+                {"model_precision", CompactForest::precisionToString(scorer.getModelPrecision())},
                 {"message", scorer.isModelReady() 
                     ? "ML model is trained and ready" 
                     : "Using rule-based fallback"}
@@ -163,6 +517,144 @@ int main() {
         res.set_content(response.dump(), "application/json");
     });
     
+    // GET /cache/stats - Hit/miss counters of the /assess-risk result cache
+    server.Get("/cache/stats", [&scorer](const httplib::Request&, httplib::Response& res) {
+        const auto& cache = scorer.getCache();
+        auto stats = cache.getStats();
+        uint64_t lookups = stats.hits + stats.misses;
+        json response = {
+            {"success", true},
+            {"status_code", 200},
+            {"data", {
+                {"enabled", cache.isEnabled()},
+                {"hits", stats.hits},
+                {"misses", stats.misses},
+                {"hit_rate", lookups > 0 ? static_cast<double>(stats.hits) / lookups : 0.0},
+                {"evictions", stats.evictions},
+                {"expirations", stats.expirations},
+                {"entries", stats.entries},
+                {"capacity", stats.capacity},
+                {"ttl_seconds", cache.getTtl().count()}
+            }}
+        };
+        res.set_content(response.dump(), "application/json");
+    });
+    
+    // GET /model/importances - Impurity-based and held-out permutation importances of the current model
+    server.Get("/model/importances", [&scorer](const httplib::Request&, httplib::Response& res) {
+        try {
+            auto report = scorer.computeFeatureImportances();
+            
+            json response = {
+                {"success", true},
+                {"message", "Feature importances computed successfully"},
+                {"status_code", 200},
+                {"data", {
+                    {"model_version", report.modelVersion},
+                    {"holdout_rows", report.holdoutRows},
+                    {"impurity", report.impurity},
+                    {"permutation", report.permutation}
+                }}
+            };
+            res.set_content(response.dump(), "application/json");
+        }
+        catch (const std::exception& e) {
+            auto response = sdrs::models::Response<void>::error(std::string("Feature importance failed: ") + e.what());
+            res.status = response.getStatusCode();
+            res.set_content(response.toJson(), "application/json");
+        }
+    });
+    
+    // GET /model/precision - Accuracy and size of the float64, float32 and uint16 variants of the current model
+    server.Get("/model/precision", [&scorer](const httplib::Request&, httplib::Response& res) {
+        try {
+            json reports = json::array();
+            for (auto precision : {ModelPrecision::Float64, ModelPrecision::Float32, ModelPrecision::Quantized16}) {
+                auto report = scorer.evaluatePrecision(precision);
+                reports.push_back({
+                    {"precision", CompactForest::precisionToString(report.precision)},
+                    {"model_version", report.modelVersion},
+                    {"holdout_rows", report.holdoutRows},
+                    {"node_count", report.nodeCount},
+                    {"memory_bytes", report.memoryBytes},
+                    {"reference_memory_bytes", report.referenceMemoryBytes},
+                    {"max_abs_delta", report.maxAbsDelta},
+                    {"mean_abs_delta", report.meanAbsDelta},
+                    {"mse", report.mse},
+                    {"reference_mse", report.referenceMse},
+                    {"risk_level_agreement", report.riskLevelAgreement}
+                });
+            }
+            
+            json response = {
+                {"success", true},
+                {"status_code", 200},
+                {"data", {
+                    {"current", CompactForest::precisionToString(scorer.getModelPrecision())},
+                    {"reports", reports}
+                }}
+            };
+            res.set_content(response.dump(), "application/json");
+        }
+        catch (const std::exception& e) {
+            auto response = sdrs::models::Response<void>::error(std::string("Precision report failed: ") + e.what());
+            res.status = response.getStatusCode();
+            res.set_content(response.toJson(), "application/json");
+        }
+    });
+    
+    // POST /model/precision - Score with another precision from now on
+    // Body: {"precision": "float64" | "float32" | "uint16"}; the current model is republished under a new version
+    server.Post("/model/precision", [&scorer](const httplib::Request& req, httplib::Response& res) {
+        try {
+            auto j = json::parse(req.body);
+            uint64_t version = scorer.setModelPrecision(CompactForest::stringToPrecision(j.value("precision", "")));
+            
+            json response = {
+                {"success", true},
+                {"message", "Model precision updated successfully"},
+                {"status_code", 200},
+                {"data", {
+                    {"precision", CompactForest::precisionToString(scorer.getModelPrecision())},
+                    {"model_version", version}
+                }}
+            };
+            res.set_content(response.dump(), "application/json");
+        }
+        catch (const sdrs::exceptions::ValidationException& e) {
+            auto response = sdrs::models::Response<void>::badRequest(std::string("Precision change failed: ") + e.what());
+            res.status = response.getStatusCode();
+            res.set_content(response.toJson(), "application/json");
+        }
+        catch (const std::exception& e) {
+            auto response = sdrs::models::Response<void>::error(std::string("Precision change failed: ") + e.what());
+            res.status = response.getStatusCode();
+            res.set_content(response.toJson(), "application/json");
+        }
+    });
+    
+    // POST /model/reload - Swap in the active model artifact without a restart
+    // Only the artifact the registry (or SDRS_RISK_MODEL_PATH) names is loaded, never a path from the
+    // request; in-flight requests finish on the previous model
+    server.Post("/model/reload", [&modelWatcher](const httplib::Request&, httplib::Response& res) {
+        try {
+            uint64_t version = modelWatcher.reload();
+            
+            json response = {
+                {"success", true},
+                {"message", "Model reloaded successfully"},
+                {"status_code", 200},
+                {"data", {{"model_version", version}}}
+            };
+            res.set_content(response.dump(), "application/json");
+        }
+        catch (const std::exception& e) {
+            auto response = sdrs::models::Response<void>::error(std::string("Model reload failed: ") + e.what());
+            res.status = response.getStatusCode();
+            res.set_content(response.toJson(), "application/json");
+        }
+    });
+    
     const int port = sdrs::constants::ports::RISK_SERVICE_PORT;
     std::cout << "Risk Assessment Service listening on port " << port << std::endl;
     sdrs::utils::Logger::Info("Risk Assessment Service started on port " + std::to_string(port));
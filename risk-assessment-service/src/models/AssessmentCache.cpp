@@ -0,0 +1,310 @@
+// AssessmentCache.cpp - Implementation
+
+#include "../../include/models/AssessmentCache.h"
+#include <algorithm>
+#include <bit>
+
+namespace sdrs::risk
+{
+
+namespace
+{
+
+// +0.0 folds -0.0 into 0.0 so equal amounts always encode the same
+uint64_t canonical(double value)
+{
+    return std::bit_cast<uint64_t>(value + 0.0);
+}
+
+uint64_t canonical(int64_t value)
+{
+    return static_cast<uint64_t>(value);
+}
+
+// splitmix64 finalizer: cheap, and every input bit affects every output bit
+uint64_t mix(uint64_t value)
+{
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+}
+
+AssessmentKey AssessmentKey::make(const RiskFeatures& features, uint64_t modelVersion)
+{
+    AssessmentKey key;
+    key.words = {
+        modelVersion,
+        canonical(int64_t{features.accountId}),
+        canonical(int64_t{features.borrowerId}),
+        canonical(features.loanAmount.getAmount()),
+        canonical(features.remainingAmount.getAmount()),
+        canonical(features.interestRate),
+        canonical(int64_t{features.daysPastDue}),
+        canonical(int64_t{features.numberOfMissedPayments}),
+        canonical(static_cast<int64_t>(features.accountStatus)),
+        canonical(int64_t{features.age}),
+        canonical(features.monthlyIncome.getAmount()),
+        canonical(static_cast<int64_t>(features.employmentStatus)),
+        canonical(int64_t{features.accountAgeMonths})
+    };
+
+    uint64_t hash = 0;
+    for (uint64_t word : key.words)
+    {
+        hash = mix(hash ^ word);
+    }
+    key.hash = hash;
+    return key;
+}
+
+bool AssessmentKey::operator==(const AssessmentKey& other) const
+{
+    return (hash == other.hash)
+    && (words == other.words);
+}
+
+// Entries are addressed by 32-bit index; the index keeps at most half its slots in use so probe runs stay short
+AssessmentCache::AssessmentCache(size_t capacity, std::chrono::seconds ttl, size_t numShards)
+    : _shards(std::max<size_t>(numShards, 1)),
+    _shardCapacity(std::min<size_t>((capacity + _shards.size() - 1) / _shards.size(), NO_ENTRY / 2)),
+    _ttl(ttl),
+    _hits(0),
+    _misses(0),
+    _evictions(0),
+    _expirations(0)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    for (auto& shard : _shards)
+    {
+        shard.entries.resize(_shardCapacity);
+        shard.slots.resize(std::bit_ceil(_shardCapacity * 2));
+        shard.reset();
+    }
+}
+
+std::optional<CachedScore> AssessmentCache::find(const AssessmentKey& key)
+{
+    if (!isEnabled())
+    {
+        return std::nullopt;
+    }
+
+    auto& shard = shardFor(key);
+    auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        size_t slot = shard.findSlot(key);
+        if (slot != shard.slots.size())
+        {
+            uint32_t index = shard.slots[slot];
+            const Entry& entry = shard.entries[index];
+            if (entry.expiresAt > now)
+            {
+                shard.unlink(index);
+                shard.pushNewest(index);
+                ++_hits;
+                return entry.score;
+            }
+
+            shard.remove(slot);
+            ++_expirations;
+        }
+    }
+
+    ++_misses;
+    return std::nullopt;
+}
+
+void AssessmentCache::insert(const AssessmentKey& key, const CachedScore& score)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    auto& shard = shardFor(key);
+    auto expiresAt = std::chrono::steady_clock::now() + _ttl;
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    size_t slot = shard.findSlot(key);
+    if (slot != shard.slots.size())
+    {
+        // Another thread scored the same inputs first; keep the newer result
+        uint32_t index = shard.slots[slot];
+        shard.entries[index].score = score;
+        shard.entries[index].expiresAt = expiresAt;
+        shard.unlink(index);
+        shard.pushNewest(index);
+        return;
+    }
+
+    if (shard.freeList == NO_ENTRY)
+    {
+        shard.remove(shard.findSlot(shard.entries[shard.oldest].key));
+        ++_evictions;
+    }
+
+    uint32_t index = shard.freeList;
+    Entry& entry = shard.entries[index];
+    shard.freeList = entry.older;
+    entry.key = key;
+    entry.score = score;
+    entry.expiresAt = expiresAt;
+    shard.pushNewest(index);
+    shard.insertSlot(index);
+    ++shard.size;
+}
+
+void AssessmentCache::clear()
+{
+    for (auto& shard : _shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.reset();
+    }
+}
+
+AssessmentCacheStats AssessmentCache::getStats() const
+{
+    AssessmentCacheStats stats;
+    stats.hits = _hits.load(std::memory_order_relaxed);
+    stats.misses = _misses.load(std::memory_order_relaxed);
+    stats.evictions = _evictions.load(std::memory_order_relaxed);
+    stats.expirations = _expirations.load(std::memory_order_relaxed);
+    stats.capacity = _shardCapacity * _shards.size();
+
+    for (const auto& shard : _shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.entries += shard.size;
+    }
+    return stats;
+}
+
+AssessmentCache::Shard& AssessmentCache::shardFor(const AssessmentKey& key)
+{
+    // High bits pick the shard; the shard's slot index uses the low ones
+    return _shards[(key.hash >> 32) % _shards.size()];
+}
+
+bool AssessmentCache::isEnabled() const { return _shardCapacity > 0; }
+std::chrono::seconds AssessmentCache::getTtl() const { return _ttl; }
+
+// ---------------------------------------------------------------------------
+// Shard: intrusive LRU list, free list and slot index over the preallocated entries
+// ---------------------------------------------------------------------------
+
+void AssessmentCache::Shard::reset()
+{
+    std::fill(slots.begin(), slots.end(), NO_ENTRY);
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        entries[i].newer = NO_ENTRY;
+        entries[i].older = (i + 1 < entries.size()) ? static_cast<uint32_t>(i + 1) : NO_ENTRY;
+    }
+    newest = NO_ENTRY;
+    oldest = NO_ENTRY;
+    freeList = entries.empty() ? NO_ENTRY : 0;
+    size = 0;
+}
+
+size_t AssessmentCache::Shard::findSlot(const AssessmentKey& key) const
+{
+    size_t mask = slots.size() - 1;
+    for (size_t slot = key.hash & mask; slots[slot] != NO_ENTRY; slot = (slot + 1) & mask)
+    {
+        if (entries[slots[slot]].key == key)
+        {
+            return slot;
+        }
+    }
+    return slots.size();
+}
+
+void AssessmentCache::Shard::insertSlot(uint32_t entry)
+{
+    size_t mask = slots.size() - 1;
+    size_t slot = entries[entry].key.hash & mask;
+    while (slots[slot] != NO_ENTRY)
+    {
+        slot = (slot + 1) & mask;
+    }
+    slots[slot] = entry;
+}
+
+// Backward-shift deletion: later members of the probe run move into the hole unless their
+// home slot lies after it, so lookups never need tombstones
+void AssessmentCache::Shard::eraseSlot(size_t slot)
+{
+    size_t mask = slots.size() - 1;
+    size_t hole = slot;
+    for (size_t next = (hole + 1) & mask; slots[next] != NO_ENTRY; next = (next + 1) & mask)
+    {
+        size_t home = entries[slots[next]].key.hash & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+    }
+    slots[hole] = NO_ENTRY;
+}
+
+void AssessmentCache::Shard::unlink(uint32_t entry)
+{
+    Entry& current = entries[entry];
+    if (current.newer != NO_ENTRY)
+    {
+        entries[current.newer].older = current.older;
+    }
+    else
+    {
+        newest = current.older;
+    }
+
+    if (current.older != NO_ENTRY)
+    {
+        entries[current.older].newer = current.newer;
+    }
+    else
+    {
+        oldest = current.newer;
+    }
+}
+
+void AssessmentCache::Shard::pushNewest(uint32_t entry)
+{
+    Entry& current = entries[entry];
+    current.newer = NO_ENTRY;
+    current.older = newest;
+    if (newest != NO_ENTRY)
+    {
+        entries[newest].newer = entry;
+    }
+    else
+    {
+        oldest = entry;
+    }
+    newest = entry;
+}
+
+void AssessmentCache::Shard::remove(size_t slot)
+{
+    uint32_t entry = slots[slot];
+    eraseSlot(slot);
+    unlink(entry);
+    entries[entry].older = freeList;
+    freeList = entry;
+    --size;
+}
+
+}
@@ -0,0 +1,109 @@
+// BorrowerSegmenter.cpp - Implementation
+
+#include "../../include/models/BorrowerSegmenter.h"
+#include "../../../common/include/utils/Logger.h"
+#include "../../../common/include/exceptions/ValidationException.h"
+
+using namespace sdrs::constants::risk;
+using namespace sdrs::exceptions;
+
+namespace sdrs::risk
+{
+
+BorrowerSegmenter::BorrowerSegmenter(BorrowerSegmentRepository& repository, int pageSize)
+    : _repository(repository),
+    _pageSize(pageSize)
+{
+    if (pageSize <= 0)
+    {
+        throw ValidationException("Page size must be positive", "batch_size");
+    }
+}
+
+size_t BorrowerSegmenter::scanPages(
+    const std::function<void(const std::vector<SegmentFeatureRow>&, const std::vector<std::vector<double>>&)>& onPage)
+{
+    std::vector<SegmentFeatureRow> rows;
+    std::vector<std::vector<double>> scaled;
+    size_t total = 0;
+    int lastAccountId = 0;
+
+    while (true)
+    {
+        _repository.findFeaturePage(lastAccountId, _pageSize, rows);
+        if (rows.empty()) break;
+
+        scaled.resize(rows.size(), std::vector<double>(SEGMENT_NUM_FEATURES));
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            for (size_t f = 0; f < SEGMENT_NUM_FEATURES; ++f)
+            {
+                scaled[i][f] = rows[i].values[f] / FEATURE_SCALES[f];
+            }
+        }
+        scaled.resize(rows.size());
+
+        onPage(rows, scaled);
+
+        total += rows.size();
+        lastAccountId = rows.back().accountId;
+        if (static_cast<int>(rows.size()) < _pageSize) break;
+    }
+
+    return total;
+}
+
+SegmentationSummary BorrowerSegmenter::run(int numClusters, int passes)
+{
+    if (passes <= 0)
+    {
+        throw ValidationException("Passes must be positive", "passes");
+    }
+
+    KMeansClustering kmeans(numClusters);
+
+    for (int pass = 0; pass < passes; ++pass)
+    {
+        size_t seen = scanPages([&kmeans](const std::vector<SegmentFeatureRow>&, const std::vector<std::vector<double>>& batch) {
+            kmeans.partialFit(batch);
+        });
+
+        if (seen == 0)
+        {
+            throw ValidationException("No borrower accounts to segment", "borrower_segments");
+        }
+    }
+
+    SegmentationSummary summary;
+    summary.numClusters = numClusters;
+    summary.passes = passes;
+    summary.clusterSizes.assign(numClusters, 0);
+
+    std::vector<BorrowerSegment> segments;
+    summary.accountsSegmented = scanPages([&](const std::vector<SegmentFeatureRow>& rows, const std::vector<std::vector<double>>& batch) {
+        segments.resize(rows.size());
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            ClusterResult result = kmeans.predict(batch[i]);
+            segments[i] = BorrowerSegment{rows[i].accountId, rows[i].borrowerId, result.clusterId, result.distanceToCentroid};
+            summary.inertia += result.distanceToCentroid * result.distanceToCentroid;
+            ++summary.clusterSizes[result.clusterId];
+        }
+        _repository.saveSegments(segments, "MiniBatchKMeans");
+    });
+
+    for (auto centroid : kmeans.getCentroids())
+    {
+        for (size_t f = 0; f < SEGMENT_NUM_FEATURES; ++f)
+        {
+            centroid[f] *= FEATURE_SCALES[f];
+        }
+        summary.centroids.push_back(std::move(centroid));
+    }
+
+    sdrs::utils::Logger::Info("[BorrowerSegmenter] Segmented " + std::to_string(summary.accountsSegmented)
+        + " accounts into " + std::to_string(numClusters) + " clusters");
+    return summary;
+}
+
+}
@@ -0,0 +1,282 @@
+// IncrementalRescorer.cpp - Implementation
+
+#include "../../include/models/IncrementalRescorer.h"
+#include "../../include/models/AssessmentCache.h"
+#include "../../../common/include/utils/Logger.h"
+#include "../../../common/include/exceptions/ValidationException.h"
+#include <cmath>
+
+using namespace sdrs::constants::risk;
+using namespace sdrs::exceptions;
+
+namespace sdrs::risk
+{
+
+IncrementalRescorer::IncrementalRescorer(
+    RiskScorer& scorer,
+    AccountFeatureRepository& features,
+    RiskAssessmentRepository& assessments,
+    std::chrono::seconds interval,
+    int pageSize)
+    : _scorer(scorer),
+    _features(features),
+    _assessments(assessments),
+    _interval(interval),
+    _pageSize(pageSize),
+    _stopping(false),
+    _scoredModelVersion(0),
+    _fullPasses(0)
+{
+    if (pageSize <= 0)
+    {
+        throw ValidationException("Page size must be positive", "page_size");
+    }
+}
+
+IncrementalRescorer::~IncrementalRescorer()
+{
+    stop();
+}
+
+void IncrementalRescorer::start()
+{
+    if (_thread.joinable() || _interval.count() <= 0)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_stateMutex);
+        _stopping = false;
+    }
+    _thread = std::thread(&IncrementalRescorer::run, this);
+}
+
+void IncrementalRescorer::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_stateMutex);
+        _stopping = true;
+    }
+    _wakeup.notify_all();
+
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+}
+
+void IncrementalRescorer::run()
+{
+    std::unique_lock<std::mutex> lock(_stateMutex);
+    while (!_wakeup.wait_for(lock, _interval, [this] { return _stopping; }))
+    {
+        lock.unlock();
+        try
+        {
+            runOnce();
+        }
+        catch (const std::exception& e)
+        {
+            // The watermark only moves after a pass succeeds, so the next poll re-reads the same changes
+            sdrs::utils::Logger::Warn("[IncrementalRescorer] Pass failed: " + std::string(e.what()));
+        }
+        lock.lock();
+    }
+}
+
+RescoreSummary IncrementalRescorer::runOnce()
+{
+    std::lock_guard<std::mutex> lock(_passMutex);
+    bool fullPass = (_watermark.empty())
+        || (_scorer.getActiveModelVersion() != _scoredModelVersion);
+    return runPassLocked(fullPass);
+}
+
+RescoreSummary IncrementalRescorer::runFullPass()
+{
+    std::lock_guard<std::mutex> lock(_passMutex);
+    return runPassLocked(true);
+}
+
+RescoreSummary IncrementalRescorer::runPassLocked(bool fullPass)
+{
+    auto started = std::chrono::steady_clock::now();
+
+    RescoreSummary summary;
+    summary.fullPass = fullPass;
+    summary.modelVersion = _scorer.getActiveModelVersion();
+    if (fullPass)
+    {
+        ++_fullPasses;
+    }
+
+    // Taken before reading: a change racing the scan is picked up by the next pass
+    std::string watermark = _features.currentWatermark();
+
+    std::vector<RiskFeatures> page;
+    page.reserve(_pageSize);
+    int afterAccountId = 0;
+    while (true)
+    {
+        if (fullPass)
+        {
+            _features.findFeaturePage(afterAccountId, _pageSize, page);
+        }
+        else
+        {
+            _features.findChangedPage(_watermark, RESCORE_LOOKBACK_SECONDS, afterAccountId, _pageSize, page);
+        }
+
+        if (page.empty())
+        {
+            break;
+        }
+
+        rescorePage(page, summary.modelVersion, fullPass, summary);
+        afterAccountId = page.back().accountId;
+
+        if (static_cast<int>(page.size()) < _pageSize)
+        {
+            break;
+        }
+    }
+
+    if (fullPass)
+    {
+        // Accounts that are gone or belong to inactive borrowers
+        std::erase_if(_accounts, [this](const auto& entry) {
+            return entry.second.lastFullPass != _fullPasses;
+        });
+    }
+
+    _watermark = watermark;
+    _scoredModelVersion = summary.modelVersion;
+
+    summary.accountsTracked = _accounts.size();
+    summary.durationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+    sdrs::utils::Logger::Info("[IncrementalRescorer] " + std::string(fullPass ? "Full" : "Incremental") + " pass: "
+        + std::to_string(summary.accountsRescored) + " of " + std::to_string(summary.accountsExamined)
+        + " accounts rescored, " + std::to_string(summary.assessmentsWritten) + " written, "
+        + std::to_string(summary.riskLevelChanges) + " risk level changes");
+    return summary;
+}
+
+void IncrementalRescorer::rescorePage(const std::vector<RiskFeatures>& page, uint64_t modelVersion, bool fullPass, RescoreSummary& summary)
+{
+    summary.accountsExamined += page.size();
+    seedAccounts(page);
+
+    std::vector<RiskFeatures> changed;
+    std::vector<uint64_t> fingerprints;
+    for (const auto& features : page)
+    {
+        uint64_t fingerprint = AssessmentKey::make(features, modelVersion).hash;
+        auto found = _accounts.find(features.accountId);
+        if (found != _accounts.end())
+        {
+            if (fullPass)
+            {
+                found->second.lastFullPass = _fullPasses;
+            }
+            if (found->second.fingerprint == fingerprint)
+            {
+                continue;
+            }
+        }
+        changed.push_back(features);
+        fingerprints.push_back(fingerprint);
+    }
+
+    if (changed.empty())
+    {
+        return;
+    }
+
+    auto assessments = _scorer.assessRiskBatch(changed);
+    summary.accountsRescored += assessments.size();
+
+    // An unchanged score only refreshes the fingerprint; the newest stored row still holds
+    std::vector<RiskAssessment> moved;
+    std::vector<uint64_t> movedFingerprints;
+    for (size_t i = 0; i < assessments.size(); ++i)
+    {
+        const auto& assessment = assessments[i];
+        auto found = _accounts.find(assessment.getAccountId());
+        if ((found != _accounts.end())
+        && (found->second.scoreMillis == toScoreMillis(assessment.getRiskScore()))
+        && (found->second.riskLevel == assessment.getRiskLevel()))
+        {
+            found->second.fingerprint = fingerprints[i];
+            continue;
+        }
+        moved.push_back(assessment);
+        movedFingerprints.push_back(fingerprints[i]);
+    }
+
+    if (moved.empty())
+    {
+        return;
+    }
+
+    std::vector<size_t> rejected;
+    summary.assessmentsWritten += _assessments.createBatch(moved, &rejected);
+
+    // State moves only for stored rows, so a failed save is retried next pass
+    auto nextRejected = rejected.begin();
+    for (size_t i = 0; i < moved.size(); ++i)
+    {
+        if ((nextRejected != rejected.end())
+        && (*nextRejected == i))
+        {
+            ++nextRejected;
+            continue;
+        }
+
+        const auto& assessment = moved[i];
+        auto [entry, inserted] = _accounts.try_emplace(assessment.getAccountId());
+        if ((!inserted)
+        && (entry->second.riskLevel != assessment.getRiskLevel()))
+        {
+            ++summary.riskLevelChanges;
+        }
+        entry->second.fingerprint = movedFingerprints[i];
+        entry->second.lastFullPass = _fullPasses;
+        entry->second.scoreMillis = toScoreMillis(assessment.getRiskScore());
+        entry->second.riskLevel = assessment.getRiskLevel();
+    }
+}
+
+void IncrementalRescorer::seedAccounts(const std::vector<RiskFeatures>& page)
+{
+    std::vector<int> unknown;
+    for (const auto& features : page)
+    {
+        if (!_accounts.contains(features.accountId))
+        {
+            unknown.push_back(features.accountId);
+        }
+    }
+
+    if (unknown.empty())
+    {
+        return;
+    }
+
+    // Accounts never assessed stay unknown and are written once scored
+    for (const auto& latest : _assessments.getLatestByAccountIds(unknown))
+    {
+        auto& state = _accounts[latest.getAccountId()];
+        state.lastFullPass = _fullPasses;
+        state.scoreMillis = toScoreMillis(latest.getRiskScore());
+        state.riskLevel = latest.getRiskLevel();
+    }
+}
+
+uint16_t IncrementalRescorer::toScoreMillis(double score)
+{
+    return static_cast<uint16_t>(std::lround(score * RISK_SCORE_SCALE));
+}
+
+}
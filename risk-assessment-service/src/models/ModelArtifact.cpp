@@ -0,0 +1,163 @@
+// ModelArtifact.cpp - Implementation
+
+#include "../../include/models/ModelArtifact.h"
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace sdrs::constants;
+using namespace sdrs::constants::risk;
+using namespace sdrs::exceptions;
+
+namespace sdrs::risk
+{
+
+namespace
+{
+
+constexpr size_t SECTION_ALIGNMENT = 8;
+
+size_t alignUp(size_t offset)
+{
+    return (offset + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+}
+
+}
+
+MappedFile::MappedFile(const std::string& path)
+    : _data(nullptr),
+    _size(0)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Cannot open model file: " + path);
+    }
+
+    struct stat info{};
+    if ((::fstat(fd, &info) != 0)
+    || (info.st_size <= 0))
+    {
+        ::close(fd);
+        throw std::runtime_error("Cannot read model file: " + path);
+    }
+
+    _size = static_cast<size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // the mapping keeps its own reference to the file
+
+    if (mapping == MAP_FAILED)
+    {
+        throw std::runtime_error("Cannot map model file: " + path);
+    }
+
+    ::madvise(mapping, _size, MADV_WILLNEED);
+    _data = static_cast<const std::byte*>(mapping);
+}
+
+MappedFile::~MappedFile()
+{
+    if (_data)
+    {
+        ::munmap(const_cast<std::byte*>(_data), _size);
+    }
+}
+
+const std::byte* MappedFile::data() const { return _data; }
+size_t MappedFile::size() const { return _size; }
+
+ModelWriter::ModelWriter(ModelType type)
+{
+    ModelFileHeader header{};
+    std::strncpy(header.magic, MODEL_FILE_MAGIC, sizeof(header.magic));
+    header.formatVersion = MODEL_FORMAT_VERSION;
+    header.modelType = static_cast<uint32_t>(type);
+    header.fileSize = 0;  // patched in saveToFile
+    append(&header, sizeof(header));
+}
+
+void ModelWriter::append(const void* data, size_t size)
+{
+    size_t offset = _buffer.size();
+    _buffer.resize(alignUp(offset + size));
+    if (size > 0)
+    {
+        std::memcpy(_buffer.data() + offset, data, size);
+    }
+}
+
+void ModelWriter::saveToFile(const std::string& path)
+{
+    uint64_t fileSize = _buffer.size();
+    std::memcpy(_buffer.data() + offsetof(ModelFileHeader, fileSize), &fileSize, sizeof(fileSize));
+
+    // Readers mapping the old file keep their pages; rename swaps in the new one atomically
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            throw std::runtime_error("Cannot create model file: " + tempPath);
+        }
+        out.write(reinterpret_cast<const char*>(_buffer.data()), static_cast<std::streamsize>(_buffer.size()));
+        if (!out)
+        {
+            throw std::runtime_error("Failed to write model file: " + tempPath);
+        }
+    }
+
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(tempPath.c_str());
+        throw std::runtime_error("Failed to publish model file: " + path);
+    }
+}
+
+ModelReader::ModelReader(std::shared_ptr<const MappedFile> file, ModelType expectedType)
+    : _file(std::move(file)),
+    _offset(0)
+{
+    ModelFileHeader header = readValue<ModelFileHeader>();
+
+    if (std::strncmp(header.magic, MODEL_FILE_MAGIC, sizeof(header.magic)) != 0)
+    {
+        throw ValidationException("Not an SDRS model file", "modelPath", ValidationErrorCode::InvalidFormat);
+    }
+    if (header.formatVersion != MODEL_FORMAT_VERSION)
+    {
+        throw ValidationException("Unsupported model format version " + std::to_string(header.formatVersion),
+            "modelPath", ValidationErrorCode::InvalidFormat);
+    }
+    if (header.modelType != static_cast<uint32_t>(expectedType))
+    {
+        throw ValidationException("Model file holds a different model type", "modelPath", ValidationErrorCode::InvalidFormat);
+    }
+    if (header.fileSize != _file->size())
+    {
+        throw ValidationException("Model file is truncated", "modelPath", ValidationErrorCode::InvalidFormat);
+    }
+}
+
+const std::byte* ModelReader::take(size_t size)
+{
+    if (size > _file->size() - _offset)
+    {
+        throw ValidationException("Model file ends unexpectedly", "modelPath", ValidationErrorCode::InvalidFormat);
+    }
+
+    const std::byte* data = _file->data() + _offset;
+    _offset = std::min(alignUp(_offset + size), _file->size());
+    return data;
+}
+
+const std::shared_ptr<const MappedFile>& ModelReader::getFile() const
+{
+    return _file;
+}
+
+}
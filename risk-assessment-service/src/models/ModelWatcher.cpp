@@ -0,0 +1,128 @@
+// ModelWatcher.cpp - Implementation
+
+#include "../../include/models/ModelWatcher.h"
+#include "../../../common/include/utils/Logger.h"
+#include "../../../common/include/exceptions/ValidationException.h"
+
+using namespace sdrs::exceptions;
+
+namespace sdrs::risk
+{
+
+ModelWatcher::ModelWatcher(RiskScorer& scorer, std::function<std::string()> resolvePath, std::chrono::seconds interval)
+    : _scorer(scorer),
+    _resolvePath(std::move(resolvePath)),
+    _interval(interval),
+    _stopping(false)
+{
+    // Do nothing
+}
+
+ModelWatcher::~ModelWatcher()
+{
+    stop();
+}
+
+void ModelWatcher::start()
+{
+    if (_thread.joinable() || _interval.count() <= 0)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_stateMutex);
+        _stopping = false;
+    }
+    _thread = std::thread(&ModelWatcher::run, this);
+}
+
+void ModelWatcher::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_stateMutex);
+        _stopping = true;
+    }
+    _wakeup.notify_all();
+
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+}
+
+void ModelWatcher::run()
+{
+    std::unique_lock<std::mutex> lock(_stateMutex);
+    while (!_wakeup.wait_for(lock, _interval, [this] { return _stopping; }))
+    {
+        lock.unlock();
+        try
+        {
+            pollOnce();
+        }
+        catch (const std::exception& e)
+        {
+            // Keep serving the current model; the next poll retries
+            sdrs::utils::Logger::Warn("[ModelWatcher] Reload failed: " + std::string(e.what()));
+        }
+        lock.lock();
+    }
+}
+
+uint64_t ModelWatcher::reload()
+{
+    std::lock_guard<std::mutex> lock(_reloadMutex);
+    return reloadLocked(_resolvePath());
+}
+
+bool ModelWatcher::pollOnce()
+{
+    std::lock_guard<std::mutex> lock(_reloadMutex);
+
+    std::string modelPath = _resolvePath();
+    std::error_code error;
+    auto writeTime = std::filesystem::last_write_time(modelPath, error);
+    if (error)
+    {
+        return false;  // not published yet
+    }
+
+    if ((modelPath == _watchedPath)
+    && (writeTime == _watchedWriteTime))
+    {
+        return false;
+    }
+
+    reloadLocked(modelPath);
+    return true;
+}
+
+void ModelWatcher::markLoaded(const std::string& modelPath)
+{
+    std::lock_guard<std::mutex> lock(_reloadMutex);
+    std::error_code error;
+    _watchedPath = modelPath;
+    _watchedWriteTime = std::filesystem::last_write_time(modelPath, error);
+}
+
+uint64_t ModelWatcher::reloadLocked(const std::string& modelPath)
+{
+    if (modelPath.empty())
+    {
+        throw ValidationException("No model artifact configured", "modelPath");
+    }
+
+    // Taken before loading: a write racing the load is picked up by the next poll
+    std::error_code error;
+    auto writeTime = std::filesystem::last_write_time(modelPath, error);
+
+    uint64_t version = _scorer.reloadModel(modelPath);
+    _watchedPath = modelPath;
+    _watchedWriteTime = writeTime;
+
+    sdrs::utils::Logger::Info("[ModelWatcher] Published model version " + std::to_string(version) + " from " + modelPath);
+    return version;
+}
+
+}
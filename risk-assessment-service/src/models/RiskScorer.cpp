@@ -1,9 +1,13 @@
 // RiskScorer.cpp - Implementation
 
 #include "../../include/models/RiskScorer.h"
+#include "../../include/models/RuleBasedScorer.h"
+#include "../../include/models/AssessmentCache.h"
 #include "../../include/algorithms/RandomForest.h"
+#include "../../include/algorithms/CompactForest.h"
 #include "../../../common/include/exceptions/ValidationException.h"
 #include "../../../common/include/utils/Constants.h"
+#include "../../../common/include/utils/Logger.h"
 #include <cmath>
 #include <sstream>
 #include <algorithm>
@@ -25,7 +29,9 @@ RiskAssessment::RiskAssessment(int accountId,
     _accountId(accountId),
     _borrowerId(borrowerId),
     _riskScore(score),
-    _algorithmUsed(algorithm)
+    _algorithmUsed(algorithm),
+    _riskFactors{},
+    _riskFactorMask(0)
 {
     if (score < 0.0 || score > 1.0)
     {
@@ -35,6 +41,7 @@ RiskAssessment::RiskAssessment(int accountId,
     }
     
     _riskLevel = determineRiskLevel(score);
+    // The only clock read per assessment; filling in factors afterwards leaves the date alone
     _assessmentDate = std::chrono::floor<std::chrono::seconds>(
         std::chrono::system_clock::now()
     );
@@ -54,17 +61,47 @@ RiskLevel RiskAssessment::determineRiskLevel(double score) const
     return RiskLevel::High;
 }
 
+void RiskAssessment::setRiskFactor(RiskFactor factor, double contribution)
+{
+    auto index = static_cast<size_t>(factor);
+    _riskFactors[index] = contribution;
+    _riskFactorMask |= 1u << index;
+}
+
 void RiskAssessment::addRiskFactor(const std::string& factorName, double contribution)
 {
-    _riskFactors[factorName] = contribution;
-    touch();
+    auto factor = stringToRiskFactor(factorName);
+    if (!factor)
+    {
+        // Only the RISK_FACTOR_NAMES slots exist, so an older or foreign key cannot be kept
+        sdrs::utils::Logger::Warn("[RiskAssessment] Dropped unknown risk factor '" + factorName
+            + "' for account " + std::to_string(_accountId));
+        return;
+    }
+    setRiskFactor(*factor, contribution);
 }
 
-void RiskAssessment::touch()
+std::optional<double> RiskAssessment::getRiskFactor(RiskFactor factor) const
 {
-    _assessmentDate = std::chrono::floor<std::chrono::seconds>(
-        std::chrono::system_clock::now()
-    );
+    auto index = static_cast<size_t>(factor);
+    if ((_riskFactorMask & (1u << index)) == 0)
+    {
+        return std::nullopt;
+    }
+    return _riskFactors[index];
+}
+
+std::map<std::string, double> RiskAssessment::getRiskFactors() const
+{
+    std::map<std::string, double> factors;
+    for (size_t i = 0; i < NUM_RISK_FACTORS; ++i)
+    {
+        if (_riskFactorMask & (1u << i))
+        {
+            factors.emplace(RISK_FACTOR_NAMES[i], _riskFactors[i]);
+        }
+    }
+    return factors;
 }
 
 int RiskAssessment::getAssessmentId() const { return _assessmentId; }
@@ -74,7 +111,6 @@ RiskLevel RiskAssessment::getRiskLevel() const { return _riskLevel; }
 AlgorithmUsed RiskAssessment::getAlgorithmUsed() const { return _algorithmUsed; }
 std::chrono::sys_seconds RiskAssessment::getAssessmentDate() const { return _assessmentDate; }
 std::chrono::sys_seconds RiskAssessment::getCreatedAt() const { return _createdAt; }
-const std::map<std::string, double>& RiskAssessment::getRiskFactors() const { return _riskFactors; }
 double RiskAssessment::getRiskScore() const { return _riskScore; }
 
 std::string RiskAssessment::toJson() const
@@ -89,10 +125,11 @@ std::string RiskAssessment::toJson() const
         << ",\"algorithm\":\"" << (_algorithmUsed == AlgorithmUsed::RandomForest ? "RandomForest" : "RuleBased") << "\""
         << ",\"risk_factors\":{";
     bool first = true;
-    for (const auto& [key, value] : _riskFactors)
+    for (size_t i = 0; i < NUM_RISK_FACTORS; ++i)
     {
+        if ((_riskFactorMask & (1u << i)) == 0) continue;
         if (!first) oss << ",";
-        oss << "\"" << key << "\":" << value;
+        oss << "\"" << RISK_FACTOR_NAMES[i] << "\":" << _riskFactors[i];
         first = false;
     }
     oss << "}}";
@@ -131,6 +168,23 @@ RiskLevel RiskAssessment::stringToRiskLevel(const std::string& levelStr)
     return RiskLevel::Medium;
 }
 
+std::string_view RiskAssessment::riskFactorToString(RiskFactor factor)
+{
+    return RISK_FACTOR_NAMES[static_cast<size_t>(factor)];
+}
+
+std::optional<RiskFactor> RiskAssessment::stringToRiskFactor(std::string_view name)
+{
+    for (size_t i = 0; i < NUM_RISK_FACTORS; ++i)
+    {
+        if (RISK_FACTOR_NAMES[i] == name)
+        {
+            return static_cast<RiskFactor>(i);
+        }
+    }
+    return std::nullopt;
+}
+
 RiskFeatures::RiskFeatures()
 {
     // Do nothing
@@ -158,7 +212,12 @@ void RiskFeatures::validate() const
     }
 }
 
-RiskScorer::RiskScorer() : _randomForest(nullptr), _useMLModel(false), _isModelTrained(false)
+RiskScorer::RiskScorer(size_t cacheCapacity, std::chrono::seconds cacheTtl)
+    : _model(nullptr),
+    _useMLModel(false),
+    _lastModelVersion(0),
+    _precision(ModelPrecision::Float64),
+    _cache(std::make_unique<AssessmentCache>(cacheCapacity, cacheTtl))
 {
     // Do nothing
 }
@@ -170,11 +229,17 @@ RiskAssessment RiskScorer::assessRisk(const RiskFeatures& features)
     double riskScore;
     AlgorithmUsed algorithm;
     
-    if (_useMLModel && _isModelTrained && _randomForest)
+    auto model = activeModel();
+    auto key = AssessmentKey::make(features, model ? model->version : 0);
+    if (auto cached = _cache->find(key))
     {
-        auto rawFeatures = extractFeatures(features);
-        auto normalized = normalizeFeatures(rawFeatures);
-        riskScore = predictWithML(normalized);
+        return buildAssessment(features, cached->riskScore, cached->algorithm);
+    }
+    
+    if (model)
+    {
+        FeatureRecord normalized = normalizeFeatures(extractFeatures(features));
+        riskScore = predictWithML(*model, normalized);
         algorithm = AlgorithmUsed::RandomForest;
     }
     else
@@ -183,21 +248,56 @@ RiskAssessment RiskScorer::assessRisk(const RiskFeatures& features)
         algorithm = AlgorithmUsed::RuleBase;
     }
     
+    _cache->insert(key, CachedScore{riskScore, algorithm});
+    return buildAssessment(features, riskScore, algorithm);
+}
+
+std::vector<RiskAssessment> RiskScorer::assessRiskBatch(std::span<const RiskFeatures> features)
+{
+    for (const auto& row : features)
+    {
+        row.validate();
+    }
+
+    std::vector<RiskAssessment> assessments;
+    assessments.reserve(features.size());
+
+    if (auto model = activeModel())
+    {
+        auto scores = predictBatchWithML(*model, features);
+        for (size_t i = 0; i < features.size(); ++i)
+        {
+            assessments.push_back(buildAssessment(features[i], scores[i], AlgorithmUsed::RandomForest));
+        }
+    }
+    else
+    {
+        std::vector<double> scores(features.size());
+        RuleBasedScorer::scoreBatch(features, scores);
+        for (size_t i = 0; i < features.size(); ++i)
+        {
+            assessments.push_back(buildAssessment(features[i], scores[i], AlgorithmUsed::RuleBase));
+        }
+    }
+
+    return assessments;
+}
+
+RiskAssessment RiskScorer::buildAssessment(const RiskFeatures& features, double riskScore, AlgorithmUsed algorithm) const
+{
     riskScore = std::max(0.0, std::min(1.0, riskScore));
     RiskAssessment assessment(features.accountId, features.borrowerId, riskScore, algorithm);
-    auto contributions = calculateFeatureContributions(features, riskScore);
-    for (const auto& [feature, contrib] : contributions)
+    RiskFactorValues contributions = calculateFeatureContributions(features, assessment.getRiskScore());
+    for (size_t i = 0; i < NUM_RISK_FACTORS; ++i)
     {
-        assessment.addRiskFactor(feature, contrib);
+        assessment.setRiskFactor(static_cast<RiskFactor>(i), contributions[i]);
     }
     return assessment;
 }
 
-std::vector<double> RiskScorer::extractFeatures(const RiskFeatures& input) const
+RiskScorer::FeatureRecord RiskScorer::extractFeatures(const RiskFeatures& input) const
 {
-    constexpr size_t EXPECTED_FEATURE = 9;  // Updated: added Age
-
-    std::vector<double> features = {
+    return FeatureRecord{
         static_cast<double>(input.daysPastDue),
         static_cast<double>(input.numberOfMissedPayments),
         input.remainingAmount.getAmount() / (input.loanAmount.getAmount() + 1e-6),
@@ -205,162 +305,100 @@ std::vector<double> RiskScorer::extractFeatures(const RiskFeatures& input) const
         input.monthlyIncome.getAmount(),
         static_cast<double>(input.accountAgeMonths),
         static_cast<double>(input.age),  // NEW: Age feature
-        encodeEmploymentStatus(input.employmentStatus),
-        encodeAccountStatus(input.accountStatus)
+        RuleBasedScorer::encodeEmployment(input.employmentStatus),
+        RuleBasedScorer::encodeAccount(input.accountStatus)
     };
-
-    if (features.size() != EXPECTED_FEATURE)
-    {
-        throw ValidationException("Feature size mismatch");
-    }
-
-    return features;
 }
 
-std::vector<double> RiskScorer::normalizeFeatures(const std::vector<double>& raw) const
+RiskScorer::FeatureRecord RiskScorer::normalizeFeatures(const FeatureRecord& raw) const
 {
-    std::vector<double> normalized;
-    std::vector<double> maxVals = {
-        MAX_DAYS_PAST_DUE,         // [0] days_past_due
-        MAX_MISSED_PAYMENTS,        // [1] missed_payments
-        MAX_REMAINING_BALANCE_RATIO,// [2] debt_ratio
-        MAX_INTEREST_RATE,          // [3] interest_rate
-        MAX_MONTHLY_INCOME,         // [4] monthly_income
-        MAX_LOAN_TERM,              // [5] account_age_months (in months, so MAX_LOAN_TERM=120 is appropriate)
-        100.0,                      // [6] age (max 100 years)
-        MAX_EMPLOYMENT_RISK_SCORE,  // [7] employment_status (encoded)
-        MAX_ACCOUNT_STATUS_RISK_SCORE// [8] account_status (encoded)
-    };
-    for (size_t i = 0; i < raw.size(); ++i)
+    FeatureRecord normalized;
+    for (size_t i = 0; i < NUM_FEATURES; ++i)
     {
-        normalized.push_back(std::min(1.0, raw[i] / maxVals[i]));
+        normalized[i] = std::min(1.0, raw[i] / FEATURE_MAX_VALUES[i]);
     }
     return normalized;
 }
 
-double RiskScorer::predictWithML(const std::vector<double>& features) const
+double RiskScorer::predictWithML(const ScoringModel& model, const FeatureRecord& features) const
 {
-    return _randomForest->predict(features);
+    if (model.compact)
+    {
+        return model.compact->predict(features.data());
+    }
+    return model.forest->predict(features.data());
 }
 
-double RiskScorer::calculateRuleBasedScore(const RiskFeatures& features) const
+std::vector<double> RiskScorer::predictBatchWithML(const ScoringModel& model, std::span<const RiskFeatures> features) const
 {
-    double score = 0.0;
+    size_t numRows = features.size();
+    std::vector<double> columns(NUM_FEATURES * numRows);
 
-    if (features.daysPastDue >= DPD_HIGH_THRESHOLD)
-    {
-        score += 0.40;
-    }
-    else if (features.daysPastDue >= DPD_MEDIUM_THRESHOLD)
-    {
-        score += 0.30;
-    }
-    else if (features.daysPastDue >= DPD_LOW_THRESHOLD)
-    {
-        score += 0.20;
-    }
-    else 
+    for (size_t i = 0; i < numRows; ++i)
     {
-        score += features.daysPastDue / DPD_DEFAULT_THRESHOLD * 0.20;
-    }
-    
-    score += std::min(0.30, features.numberOfMissedPayments * 0.10);
-    
-    double debtRatio = features.remainingAmount.getAmount() / (features.loanAmount.getAmount() + 1e-6);
-    score += debtRatio * 0.20;
-    
-    // If no income (0 VND) and has debt -> VERY HIGH RISK
-    double monthlyIncome = features.monthlyIncome.getAmount();
-    // Calculate minimum monthly payment: (remaining * (1 + interest)) / 12 months
-    double monthlyPaymentRequired = features.remainingAmount.getAmount() * (1.0 + features.interestRate) / 12.0;
-    
-    if (monthlyIncome <= 0 && features.remainingAmount.getAmount() > 0) {
-        // No income + has debt = cannot repay!
-        score += 0.35;  // Major risk factor
-    } else if (monthlyIncome > 0) {
-        // Debt-to-Income ratio (monthly payment / monthly income)
-        double dti = monthlyPaymentRequired / (monthlyIncome + 1e-6);
-        if (dti > 0.5) {
-            score += 0.25;  // Payment > 50% of income
-        } else if (dti > 0.35) {
-            score += 0.15;  // Payment 35-50% of income
-        } else if (dti > 0.20) {
-            score += 0.10;  // Payment 20-35% of income (borderline)
-        } else if (dti > 0.10) {
-            score += 0.05;  // Payment 10-20% of income (manageable)
-        }
-        // dti <= 0.10 is very healthy, no additional risk
-    }
-    
-    // Age factor: younger borrowers (18-25) and older borrowers (65+) have higher risk
-    if (features.age > 0) {
-        if (features.age < 25) {
-            score += 0.10;  // Young, less financial stability
-        } else if (features.age >= 65) {
-            score += 0.08;  // Older, income concerns
-        } else if (features.age >= 35 && features.age <= 50) {
-            score -= 0.05;  // Prime working age, lower risk
+        FeatureRecord normalized = normalizeFeatures(extractFeatures(features[i]));
+        for (size_t f = 0; f < NUM_FEATURES; ++f)
+        {
+            columns[f * numRows + i] = normalized[f];
         }
     }
-    
-    // Account age factor: new accounts are riskier
-    if (features.accountAgeMonths > 0) {
-        if (features.accountAgeMonths < 3) {
-            score += 0.10;  // Very new account (< 3 months)
-        } else if (features.accountAgeMonths < 6) {
-            score += 0.05;  // New account (3-6 months)
-        }
-        // 6+ months is established, no additional risk
+
+    if (model.compact)
+    {
+        std::vector<double> scores(numRows);
+        model.compact->predictBatch(columns.data(), numRows, scores.data());
+        return scores;
     }
-    
-    score += getEmploymentRiskContribution(features.employmentStatus);
-    score += getAccountRiskContribution(features.accountStatus);
-    
-    return std::min(1.0, score);
+    return model.forest->predictBatch(columns, numRows);
+}
+
+double RiskScorer::calculateRuleBasedScore(const RiskFeatures& features) const
+{
+    return RuleBasedScorer::score(features);
 }
 
 void RiskScorer::trainModel()
 {
-    if (!_randomForest)
-    {
-        _randomForest = std::make_shared<RandomForest>(
-            constants::risk::RF_NUM_TREES,
-            constants::risk::RF_MAX_DEPTH,
-            constants::risk::RF_MIN_SAMPLES_SPLIT
-        );
-    }
+    // Always a fresh forest: readers may still be scoring with the current one
+    auto forest = std::make_shared<RandomForest>(
+        constants::risk::RF_NUM_TREES,
+        constants::risk::RF_MAX_DEPTH,
+        constants::risk::RF_MIN_SAMPLES_SPLIT
+    );
     
-    std::vector<std::vector<double>> X;
+    std::vector<FeatureRecord> X;
     std::vector<double> y;
     generateSyntheticData(X, y, 5000);  // Increased to 5000 samples for better model generalization
     
     std::vector<std::vector<double>> X_normalized;
     X_normalized.reserve(X.size());
     for (const auto& sample : X) {
-        X_normalized.push_back(normalizeFeatures(sample));
+        FeatureRecord normalized = normalizeFeatures(sample);
+        X_normalized.emplace_back(normalized.begin(), normalized.end());
     }
     
-    _randomForest->train(X_normalized, y);
-    _isModelTrained = true;
+    forest->train(X_normalized, y);
+    publishModel(forest, "synthetic");
     _useMLModel = true;
 }
 
 void RiskScorer::generateSyntheticData(
-    std::vector<std::vector<double>>& X,
+    std::vector<FeatureRecord>& X,
     std::vector<double>& y,
-    int numSamples) const
+    int numSamples,
+    int seed) const
 {
     X.clear();
     y.clear();
     X.reserve(numSamples);
     y.reserve(numSamples);
     
-    std::mt19937 rng(42);
+    std::mt19937 rng(seed);
     std::uniform_real_distribution<double> uniform(0.0, 1.0);
 
     for (int i = 0; i < numSamples; ++i)
     {
-        std::vector<double> features(9);  // Updated: 9 features including Age
+        FeatureRecord features{};  // Updated: 9 features including Age
         double riskScore;
 
         double scenario = uniform(rng);
@@ -477,101 +515,214 @@ void RiskScorer::generateSyntheticData(
     }
 }
 
-void RiskScorer::loadModel(const std::string& modelPath) { (void)modelPath; }
-bool RiskScorer::isModelReady() const { return _useMLModel && _isModelTrained && _randomForest && _randomForest->isTrained(); }
-void RiskScorer::setUseMLModel(bool useML) { _useMLModel = useML; }
+uint64_t RiskScorer::loadModel(const std::string& modelPath)
+{
+    uint64_t version = reloadModel(modelPath);
+    _useMLModel = true;
+    return version;
+}
+
+uint64_t RiskScorer::reloadModel(const std::string& modelPath)
+{
+    auto forest = std::make_shared<RandomForest>();
+    forest->loadModel(modelPath);
+
+    if (forest->getNumFeatures() != static_cast<int>(NUM_FEATURES))
+    {
+        throw ValidationException("Model expects " + std::to_string(forest->getNumFeatures())
+            + " features, scorer provides " + std::to_string(NUM_FEATURES), "modelPath");
+    }
+
+    return publishModel(forest, modelPath);
+}
+
+void RiskScorer::saveModel(const std::string& modelPath) const
+{
+    auto model = getModel();
+    if (!model)
+    {
+        throw ValidationException("No trained model to save", "modelPath");
+    }
+    model->forest->saveModel(modelPath);
+}
+
+uint64_t RiskScorer::publishModel(std::shared_ptr<const RandomForest> forest, const std::string& source)
+{
+    // Built before the version is taken, so versions still publish in order
+    std::shared_ptr<const CompactForest> compact;
+    ModelPrecision precision = _precision.load();
+    if (precision != ModelPrecision::Float64)
+    {
+        compact = std::make_shared<const CompactForest>(forest->getForestView(), forest->getNumFeatures(), precision);
+    }
+
+    uint64_t version = ++_lastModelVersion;
+    auto model = std::make_shared<const ScoringModel>(ScoringModel{std::move(forest), std::move(compact), version, source});
+
+    // A slower concurrent publish must not overwrite a newer model. The previous snapshot
+    // is released once the last in-flight reader drops it.
+    std::shared_ptr<const ScoringModel> current = _model.load(std::memory_order_acquire);
+    while ((!current || current->version < version)
+    && !_model.compare_exchange_weak(current, model, std::memory_order_acq_rel))
+    {
+        // current was refreshed by the failed exchange
+    }
+
+    // Entries of older versions can no longer be hit; free their slots now
+    _cache->clear();
+    return version;
+}
 
-double RiskScorer::encodeEmploymentStatus(EmploymentStatus status)
+std::shared_ptr<const ScoringModel> RiskScorer::activeModel() const
 {
-    switch (status)
+    if (!_useMLModel.load(std::memory_order_relaxed))
     {
-    case EmploymentStatus::Employed:
-    case EmploymentStatus::Contract:
-    case EmploymentStatus::SelfEmployed:
-        return 1.0;
-    case EmploymentStatus::PartTime:
-    case EmploymentStatus::Student:
-        return 0.5;
-    case EmploymentStatus::Unemployed:
-    case EmploymentStatus::Retired:
-    case EmploymentStatus::None:
-        return 0.0;
-    default:
-        return 0.0;
+        return nullptr;
     }
+    return getModel();
 }
 
-double RiskScorer::getEmploymentRiskContribution(EmploymentStatus status)
+FeatureImportanceReport RiskScorer::computeFeatureImportances() const
 {
-    switch (status)
+    auto model = getModel();
+    if (!model)
     {
-    case EmploymentStatus::Employed:
-    case EmploymentStatus::Contract:
-    case EmploymentStatus::SelfEmployed:
-        return 0.0;
-    case EmploymentStatus::PartTime:
-    case EmploymentStatus::Student:
-        return 0.05;
-    case EmploymentStatus::Unemployed:
-    case EmploymentStatus::Retired:
-    case EmploymentStatus::None:
-        return 0.10;
-    default:
-        return 0.10;
+        throw ValidationException("No trained model to explain", "model");
     }
+    
+    FeatureImportanceReport report;
+    report.modelVersion = model->version;
+    
+    for (const auto& [feature, importance] : model->forest->getFeatureImportances())
+    {
+        report.impurity[FEATURE_NAMES[feature]] = importance;
+    }
+    
+    std::vector<double> columns;
+    std::vector<double> y;
+    buildHoldoutColumns(columns, y);
+    
+    for (const auto& [feature, importance] : model->forest->computePermutationImportances(columns, y))
+    {
+        report.permutation[FEATURE_NAMES[feature]] = importance;
+    }
+    report.holdoutRows = y.size();
+    
+    return report;
+}
+
+PrecisionReport RiskScorer::evaluatePrecision(ModelPrecision precision) const
+{
+    auto model = getModel();
+    if (!model)
+    {
+        throw ValidationException("No trained model to evaluate", "model");
+    }
+    
+    const RandomForest& forest = *model->forest;
+    PrecisionReport report;
+    report.modelVersion = model->version;
+    report.precision = precision;
+    report.referenceMemoryBytes = CompactForest::flatMemoryBytes(forest.getForestView());
+    report.nodeCount = forest.getForestView().nodeCount;
+    report.memoryBytes = report.referenceMemoryBytes;
+    
+    std::vector<double> columns;
+    std::vector<double> y;
+    buildHoldoutColumns(columns, y);
+    size_t numRows = y.size();
+    
+    std::vector<double> reference = forest.predictBatch(columns, numRows);
+    std::vector<double> scores = reference;
+    if (precision != ModelPrecision::Float64)
+    {
+        CompactForest compact(forest.getForestView(), forest.getNumFeatures(), precision);
+        compact.predictBatch(columns.data(), numRows, scores.data());
+        report.nodeCount = compact.getNodeCount();
+        report.memoryBytes = compact.getMemoryBytes();
+    }
+    
+    // Scores are clamped to [0, 1] before they become assessments, so compare them that way
+    auto riskBand = [](double score) {
+        return (score >= LOW_RISK_MAX) + (score >= MEDIUM_RISK_MAX);
+    };
+    size_t sameLevel = 0;
+    double sumAbsDelta = 0.0;
+    for (size_t i = 0; i < numRows; ++i)
+    {
+        double score = std::clamp(scores[i], 0.0, 1.0);
+        double referenceScore = std::clamp(reference[i], 0.0, 1.0);
+        double delta = std::abs(score - referenceScore);
+        
+        report.maxAbsDelta = std::max(report.maxAbsDelta, delta);
+        sumAbsDelta += delta;
+        report.mse += (score - y[i]) * (score - y[i]);
+        report.referenceMse += (referenceScore - y[i]) * (referenceScore - y[i]);
+        sameLevel += riskBand(score) == riskBand(referenceScore);
+    }
+    
+    report.holdoutRows = numRows;
+    if (numRows > 0)
+    {
+        report.meanAbsDelta = sumAbsDelta / numRows;
+        report.mse /= numRows;
+        report.referenceMse /= numRows;
+        report.riskLevelAgreement = static_cast<double>(sameLevel) / numRows;
+    }
+    return report;
 }
 
-double RiskScorer::encodeAccountStatus(AccountStatus status)
+uint64_t RiskScorer::setModelPrecision(ModelPrecision precision)
 {
-    switch (status)
+    _precision = precision;
+    
+    auto model = getModel();
+    if (!model)
     {
-    case AccountStatus::PaidOff:
-    case AccountStatus::Current:
-        return 1.0;
-    case AccountStatus::Partial:
-        return 0.8;
-    case AccountStatus::Settled:
-        return 0.6;
-    case AccountStatus::Delinquent:
-        return 0.4;
-    case AccountStatus::Default:
-    case AccountStatus::ChargedOff:
-        return 0.0;
-    default:
-        return 0.5;
+        return 0;
     }
+    return publishModel(model->forest, model->source);
 }
 
-double RiskScorer::getAccountRiskContribution(AccountStatus status)
+void RiskScorer::buildHoldoutColumns(std::vector<double>& columns, std::vector<double>& y) const
 {
-    switch (status)
+    // Held-out rows come from a different seed than training, laid out column-major for predictBatch
+    std::vector<FeatureRecord> X;
+    generateSyntheticData(X, y, IMPORTANCE_HOLDOUT_SAMPLES, HOLDOUT_SEED);
+    
+    size_t numRows = X.size();
+    columns.assign(NUM_FEATURES * numRows, 0.0);
+    for (size_t i = 0; i < numRows; ++i)
     {
-    case AccountStatus::PaidOff:
-    case AccountStatus::Current:
-        return 0.0;
-    case AccountStatus::Partial:
-        return 0.02;
-    case AccountStatus::Settled:
-        return 0.04;
-    case AccountStatus::Delinquent:
-        return 0.06;
-    case AccountStatus::Default:
-    case AccountStatus::ChargedOff:
-        return 0.10;
-    default:
-        return 0.10;
+        FeatureRecord normalized = normalizeFeatures(X[i]);
+        for (size_t f = 0; f < NUM_FEATURES; ++f)
+        {
+            columns[f * numRows + i] = normalized[f];
+        }
     }
 }
 
-std::map<std::string, double> RiskScorer::calculateFeatureContributions(const RiskFeatures& features, double /* finalScore */) const
+uint64_t RiskScorer::getActiveModelVersion() const
+{
+    auto model = activeModel();
+    return model ? model->version : 0;
+}
+
+std::shared_ptr<const ScoringModel> RiskScorer::getModel() const { return _model.load(std::memory_order_acquire); }
+bool RiskScorer::isModelReady() const { return activeModel() != nullptr; }
+void RiskScorer::setUseMLModel(bool useML) { _useMLModel = useML; }
+ModelPrecision RiskScorer::getModelPrecision() const { return _precision.load(); }
+const AssessmentCache& RiskScorer::getCache() const { return *_cache; }
+
+RiskFactorValues RiskScorer::calculateFeatureContributions(const RiskFeatures& features, double /* finalScore */) const
 {
-    std::map<std::string, double> contributions;
+    RiskFactorValues contributions{};
     
-    contributions["days_past_due"] = (features.daysPastDue / MAX_DAYS_PAST_DUE) * 0.4;
-    contributions["missed_payments"] = (features.numberOfMissedPayments / MAX_MISSED_PAYMENTS) * 0.3;
-    contributions["debt_ratio"] = (features.remainingAmount.getAmount() / (features.loanAmount.getAmount() + 1e-6)) * 0.2;
-    contributions["employment"] = getEmploymentRiskContribution(features.employmentStatus);
-    contributions["account_status"] = getAccountRiskContribution(features.accountStatus);
+    contributions[static_cast<size_t>(RiskFactor::DaysPastDue)] = (features.daysPastDue / MAX_DAYS_PAST_DUE) * 0.4;
+    contributions[static_cast<size_t>(RiskFactor::MissedPayments)] = (features.numberOfMissedPayments / MAX_MISSED_PAYMENTS) * 0.3;
+    contributions[static_cast<size_t>(RiskFactor::DebtRatio)] = (features.remainingAmount.getAmount() / (features.loanAmount.getAmount() + 1e-6)) * 0.2;
+    contributions[static_cast<size_t>(RiskFactor::Employment)] = RuleBasedScorer::employmentRisk(features.employmentStatus);
+    contributions[static_cast<size_t>(RiskFactor::AccountStatus)] = RuleBasedScorer::accountRisk(features.accountStatus);
 
     return contributions;
 }
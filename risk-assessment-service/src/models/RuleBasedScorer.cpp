@@ -0,0 +1,72 @@
+// RuleBasedScorer.cpp - Implementation
+
+#include "../../include/models/RuleBasedScorer.h"
+#include "../../../common/include/exceptions/ValidationException.h"
+
+using namespace sdrs::constants;
+using namespace sdrs::exceptions;
+
+namespace sdrs::risk
+{
+
+namespace
+{
+
+// Terms are added in the order of the old if/else chain, so scores match it bit for bit
+inline double scoreRow(const RiskFeatures& features)
+{
+    using namespace rules;
+
+    int dpd = features.daysPastDue;
+    size_t dpdTier = (dpd >= DPD_TIERS[0].threshold) + (dpd >= DPD_TIERS[1].threshold) + (dpd >= DPD_TIERS[2].threshold);
+    double score = DPD_RISK[dpdTier];
+
+    score += std::min(MISSED_PAYMENT_CAP, features.numberOfMissedPayments * MISSED_PAYMENT_WEIGHT);
+
+    double loanAmount = features.loanAmount.getAmount();
+    double remainingAmount = features.remainingAmount.getAmount();
+    score += remainingAmount / (loanAmount + 1e-6) * DEBT_RATIO_WEIGHT;
+
+    // Exactly one of the two income terms can be non-zero
+    double monthlyIncome = features.monthlyIncome.getAmount();
+    double dti = remainingAmount * (1.0 + features.interestRate) / 12.0 / (monthlyIncome + 1e-6);
+    size_t dtiTier = (dti > DTI_TIERS[0].threshold) + (dti > DTI_TIERS[1].threshold)
+        + (dti > DTI_TIERS[2].threshold) + (dti > DTI_TIERS[3].threshold);
+    bool hasIncome = monthlyIncome > 0;
+    bool noIncomeWithDebt = !hasIncome && (remainingAmount > 0);
+    score += hasIncome * DTI_RISK[dtiTier] + noIncomeWithDebt * NO_INCOME_WITH_DEBT_SCORE;
+
+    score += lookup(AGE_RISK, features.age);
+    score += lookup(ACCOUNT_AGE_RISK, features.accountAgeMonths);
+    score += lookup(EMPLOYMENT_RISK, features.employmentStatus);
+    score += lookup(ACCOUNT_RISK, features.accountStatus);
+
+    return std::min(1.0, score);
+}
+
+}
+
+double RuleBasedScorer::score(const RiskFeatures& features)
+{
+    return scoreRow(features);
+}
+
+void RuleBasedScorer::scoreBatch(std::span<const RiskFeatures> features, std::span<double> scores)
+{
+    if (scores.size() != features.size())
+    {
+        throw ValidationException("Score buffer size does not match feature rows", "scores");
+    }
+
+    for (size_t i = 0; i < features.size(); ++i)
+    {
+        scores[i] = scoreRow(features[i]);
+    }
+}
+
+double RuleBasedScorer::employmentRisk(EmploymentStatus status) { return rules::lookup(rules::EMPLOYMENT_RISK, status); }
+double RuleBasedScorer::accountRisk(AccountStatus status) { return rules::lookup(rules::ACCOUNT_RISK, status); }
+double RuleBasedScorer::encodeEmployment(EmploymentStatus status) { return rules::lookup(rules::EMPLOYMENT_ENCODING, status); }
+double RuleBasedScorer::encodeAccount(AccountStatus status) { return rules::lookup(rules::ACCOUNT_ENCODING, status); }
+
+}
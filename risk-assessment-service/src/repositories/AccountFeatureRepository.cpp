@@ -0,0 +1,206 @@
+// AccountFeatureRepository.cpp - PostgreSQL implementation
+
+#include "../../include/repositories/AccountFeatureRepository.h"
+#include "../../../common/include/utils/Logger.h"
+#include "../../../common/include/utils/Constants.h"
+#include "../../../common/include/exceptions/DatabaseException.h"
+#include <algorithm>
+
+namespace sdrs::risk
+{
+
+namespace
+{
+
+constexpr int MOCK_ACCOUNT_COUNT = 300;
+
+// Every RiskFeatures field the scorer reads; months are whole calendar months
+constexpr const char* FEATURE_COLUMNS = R"(
+    SELECT la.account_id, la.borrower_id,
+           la.loan_amount::double precision AS loan_amount,
+           la.remaining_amount::double precision AS remaining_amount,
+           la.interest_rate::double precision AS interest_rate,
+           COALESCE(la.days_past_due, 0) AS days_past_due,
+           COALESCE(la.number_of_missed_payments, 0) AS missed_payments,
+           (EXTRACT(YEAR FROM age(la.loan_end_date, la.loan_start_date)) * 12
+               + EXTRACT(MONTH FROM age(la.loan_end_date, la.loan_start_date)))::int AS loan_term_months,
+           COALESCE(la.account_status, 'Current')::text AS account_status,
+           COALESCE(EXTRACT(YEAR FROM age(b.date_of_birth)), 0)::int AS age,
+           COALESCE(b.monthly_income, 0)::double precision AS monthly_income,
+           COALESCE(b.employment_status, 'None')::text AS employment_status,
+           (EXTRACT(YEAR FROM age(la.loan_start_date)) * 12
+               + EXTRACT(MONTH FROM age(la.loan_start_date)))::int AS account_age_months
+    FROM loan_accounts la
+    JOIN borrowers b ON b.borrower_id = la.borrower_id
+)";
+
+// updated_at columns are TIMESTAMP without time zone, so compare in local time
+const sdrs::database::PreparedStatement CURRENT_WATERMARK("account_feature_current_watermark", "SELECT LOCALTIMESTAMP::text");
+
+const sdrs::database::PreparedStatement FIND_FEATURE_PAGE("account_feature_find_feature_page", std::string(FEATURE_COLUMNS) + R"(
+    WHERE la.account_id > $1 AND b.is_active = true
+    ORDER BY la.account_id
+    LIMIT $2
+)");
+
+// A payment insert or status change, a DPD/balance update on the loan, or an
+// income/employment update on the borrower all change the inputs of the account's score
+const sdrs::database::PreparedStatement FIND_CHANGED_PAGE("account_feature_find_changed_page", R"(
+    WITH bound AS (
+        SELECT $1::timestamp - make_interval(secs => $2) AS ts
+    ),
+    changed AS (
+        SELECT la.account_id FROM loan_accounts la, bound
+        WHERE la.updated_at > bound.ts AND la.account_id > $3
+        UNION
+        SELECT ph.account_id FROM payment_history ph, bound
+        WHERE ph.updated_at > bound.ts AND ph.account_id > $3
+        UNION
+        SELECT la.account_id FROM borrowers bo
+        JOIN loan_accounts la ON la.borrower_id = bo.borrower_id, bound
+        WHERE bo.updated_at > bound.ts AND la.account_id > $3
+    )
+)" + std::string(FEATURE_COLUMNS) + R"(
+    JOIN changed c ON c.account_id = la.account_id
+    WHERE b.is_active = true
+    ORDER BY la.account_id
+    LIMIT $4
+)");
+
+}
+
+// Static members for mock mode
+std::vector<AccountFeatureRepository::MockAccount> AccountFeatureRepository::_mockAccounts = makeMockAccounts();
+uint64_t AccountFeatureRepository::_mockSequence = 1;
+
+AccountFeatureRepository::AccountFeatureRepository(bool useMock)
+    : _useMock(useMock)
+{
+}
+
+std::string AccountFeatureRepository::currentWatermark()
+{
+    if (_useMock) return std::to_string(_mockSequence);
+
+    try
+    {
+        auto& db = sdrs::database::DatabaseManager::getInstance();
+
+        return db.executeQuery([&](pqxx::work& txn) -> std::string {
+            return db.execPrepared(txn, CURRENT_WATERMARK)[0][0].as<std::string>();
+        });
+    }
+    catch (const pqxx::sql_error& e)
+    {
+        sdrs::utils::Logger::Error("[AccountFeatureRepo] SQL error in currentWatermark: " + std::string(e.what()));
+        throw sdrs::exceptions::DatabaseException(e.what(), sdrs::constants::DatabaseErrorCode::QueryFailed);
+    }
+}
+
+void AccountFeatureRepository::findFeaturePage(int afterAccountId, int limit, std::vector<RiskFeatures>& page)
+{
+    if (_useMock) return findPageMock(0, afterAccountId, limit, page);
+
+    try
+    {
+        auto& db = sdrs::database::DatabaseManager::getInstance();
+
+        db.executeCommand([&](pqxx::work& txn) {
+            mapRows(db.execPrepared(txn, FIND_FEATURE_PAGE, afterAccountId, limit), page);
+        });
+    }
+    catch (const pqxx::sql_error& e)
+    {
+        sdrs::utils::Logger::Error("[AccountFeatureRepo] SQL error in findFeaturePage: " + std::string(e.what()));
+        throw sdrs::exceptions::DatabaseException(e.what(), sdrs::constants::DatabaseErrorCode::QueryFailed);
+    }
+}
+
+void AccountFeatureRepository::findChangedPage(const std::string& since, int lookbackSeconds, int afterAccountId, int limit, std::vector<RiskFeatures>& page)
+{
+    if (_useMock) return findPageMock(std::stoull(since), afterAccountId, limit, page);
+
+    try
+    {
+        auto& db = sdrs::database::DatabaseManager::getInstance();
+
+        db.executeCommand([&](pqxx::work& txn) {
+            mapRows(db.execPrepared(txn, FIND_CHANGED_PAGE, since, lookbackSeconds, afterAccountId, limit), page);
+        });
+    }
+    catch (const pqxx::sql_error& e)
+    {
+        sdrs::utils::Logger::Error("[AccountFeatureRepo] SQL error in findChangedPage: " + std::string(e.what()));
+        throw sdrs::exceptions::DatabaseException(e.what(), sdrs::constants::DatabaseErrorCode::QueryFailed);
+    }
+}
+
+void AccountFeatureRepository::mapRows(const pqxx::result& result, std::vector<RiskFeatures>& page)
+{
+    page.resize(result.size());
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        const auto& row = result[i];
+        auto& out = page[i];
+        out.accountId = row["account_id"].as<int>();
+        out.borrowerId = row["borrower_id"].as<int>();
+        out.loanAmount = sdrs::money::Money(row["loan_amount"].as<double>());
+        out.remainingAmount = sdrs::money::Money(row["remaining_amount"].as<double>());
+        out.interestRate = row["interest_rate"].as<double>();
+        out.daysPastDue = row["days_past_due"].as<int>();
+        out.numberOfMissedPayments = row["missed_payments"].as<int>();
+        out.loanTermMonths = row["loan_term_months"].as<int>();
+        out.accountStatus = sdrs::constants::stringToAccountStatus(row["account_status"].as<std::string>());
+        out.age = row["age"].as<int>();
+        out.monthlyIncome = sdrs::money::Money(row["monthly_income"].as<double>());
+        out.employmentStatus = sdrs::constants::stringToEmploymentStatus(row["employment_status"].as<std::string>());
+        out.accountAgeMonths = row["account_age_months"].as<int>();
+    }
+}
+
+// ============================================================================
+// Mock Mode Implementations
+// ============================================================================
+
+// Same accounts and three loose profiles (delinquent, stretched, healthy) as the segment mock,
+// all written at sequence 1, so the first pass scores them and later change scans find nothing
+std::vector<AccountFeatureRepository::MockAccount> AccountFeatureRepository::makeMockAccounts()
+{
+    std::vector<MockAccount> accounts(MOCK_ACCOUNT_COUNT);
+    for (int i = 0; i < MOCK_ACCOUNT_COUNT; ++i)
+    {
+        int profile = i % 3;
+        auto& features = accounts[i].features;
+        features.accountId = i + 1;
+        features.borrowerId = i / 2 + 1;
+        features.loanAmount = sdrs::money::Money(50e6 + ((i * 11) % 20) * 10e6);
+        features.remainingAmount = sdrs::money::Money(features.loanAmount.getAmount() * (0.9 - 0.3 * profile));
+        features.interestRate = 0.08 + 0.02 * (i % 4);
+        features.daysPastDue = profile == 0 ? 60 + i % 30 : (profile == 1 ? i % 15 : 0);
+        features.numberOfMissedPayments = profile == 0 ? 3 + i % 3 : (profile == 1 ? i % 2 : 0);
+        features.loanTermMonths = 12 * (1 + i % 5);
+        features.accountStatus = profile == 0 ? sdrs::constants::AccountStatus::Delinquent : sdrs::constants::AccountStatus::Current;
+        features.age = 25 + 15 * profile + (i * 7) % 10;
+        features.monthlyIncome = sdrs::money::Money((8.0 + 12.0 * profile) * 1e6 + ((i * 13) % 10) * 1e5);
+        features.employmentStatus = profile == 0 ? sdrs::constants::EmploymentStatus::Unemployed : sdrs::constants::EmploymentStatus::Employed;
+        features.accountAgeMonths = 6 + (i * 5) % 48;
+        accounts[i].changeSequence = 1;
+    }
+    return accounts;
+}
+
+void AccountFeatureRepository::findPageMock(uint64_t sinceSequence, int afterAccountId, int limit, std::vector<RiskFeatures>& page)
+{
+    page.clear();
+    for (const auto& account : _mockAccounts)
+    {
+        if (static_cast<int>(page.size()) >= limit) break;
+        if ((account.features.accountId > afterAccountId)
+        && (account.changeSequence > sinceSequence))
+        {
+            page.push_back(account.features);
+        }
+    }
+}
+
+} // namespace sdrs::risk
@@ -0,0 +1,173 @@
+// BorrowerSegmentRepository.cpp - PostgreSQL implementation
+
+#include "../../include/repositories/BorrowerSegmentRepository.h"
+#include "../../../common/include/utils/Logger.h"
+#include "../../../common/include/utils/Constants.h"
+#include "../../../common/include/exceptions/DatabaseException.h"
+#include <algorithm>
+#include <format>
+
+namespace sdrs::risk
+{
+
+namespace
+{
+
+constexpr int MOCK_ACCOUNT_COUNT = 300;
+
+// Three loose borrower profiles (delinquent, stretched, healthy), interleaved by account id
+std::vector<SegmentFeatureRow> makeMockFeatures()
+{
+    std::vector<SegmentFeatureRow> rows(MOCK_ACCOUNT_COUNT);
+    for (int i = 0; i < MOCK_ACCOUNT_COUNT; ++i)
+    {
+        int profile = i % 3;
+        auto& row = rows[i];
+        row.accountId = i + 1;
+        row.borrowerId = i / 2 + 1;
+        row.values[0] = 25.0 + 15.0 * profile + (i * 7) % 10;                  // age
+        row.values[1] = (8.0 + 12.0 * profile) * 1e6 + ((i * 13) % 10) * 1e5;  // monthly_income, VND
+        row.values[2] = 0.9 - 0.3 * profile + (i % 5) * 0.01;                  // debt_ratio
+        row.values[3] = profile == 0 ? 60.0 + i % 30 : (profile == 1 ? i % 15 : 0.0);
+        row.values[4] = profile == 0 ? 3.0 + i % 3 : (profile == 1 ? i % 2 : 0.0);
+    }
+    return rows;
+}
+
+const sdrs::database::PreparedStatement FIND_FEATURE_PAGE("borrower_segment_find_feature_page", R"(
+    SELECT la.account_id, la.borrower_id,
+           COALESCE(EXTRACT(YEAR FROM age(b.date_of_birth)), 0)::double precision AS age,
+           COALESCE(b.monthly_income, 0)::double precision AS monthly_income,
+           (la.remaining_amount / la.loan_amount)::double precision AS debt_ratio,
+           COALESCE(la.days_past_due, 0)::double precision AS days_past_due,
+           COALESCE(la.number_of_missed_payments, 0)::double precision AS missed_payments
+    FROM loan_accounts la
+    JOIN borrowers b ON b.borrower_id = la.borrower_id
+    WHERE la.account_id > $1 AND b.is_active = true
+    ORDER BY la.account_id
+    LIMIT $2
+)");
+
+const sdrs::database::PreparedStatement DELETE_SEGMENTS("borrower_segment_delete_segments", "DELETE FROM borrower_segments WHERE account_id = ANY($1::int[])");
+
+const sdrs::database::PreparedStatement INSERT_SEGMENTS("borrower_segment_insert_segments", R"(
+    INSERT INTO borrower_segments (account_id, borrower_id, cluster_id, cluster_distance, algorithm_used)
+    SELECT account_id, borrower_id, cluster_id, cluster_distance, $5
+    FROM unnest($1::int[], $2::int[], $3::int[], $4::numeric[])
+        AS batch(account_id, borrower_id, cluster_id, cluster_distance)
+)");
+
+// Postgres array literal, e.g. {1,2,3}; lets one statement carry a whole batch
+template<typename T, typename Field>
+std::string toArrayLiteral(const std::vector<T>& items, Field field)
+{
+    std::string literal = "{";
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        if (i > 0) literal += ",";
+        literal += field(items[i]);
+    }
+    literal += "}";
+    return literal;
+}
+
+}
+
+// Static members for mock mode
+std::vector<SegmentFeatureRow> BorrowerSegmentRepository::_mockFeatures = makeMockFeatures();
+std::vector<BorrowerSegment> BorrowerSegmentRepository::_mockSegments;
+
+BorrowerSegmentRepository::BorrowerSegmentRepository(bool useMock)
+    : _useMock(useMock)
+{
+}
+
+void BorrowerSegmentRepository::findFeaturePage(int afterAccountId, int limit, std::vector<SegmentFeatureRow>& page)
+{
+    if (_useMock) return findFeaturePageMock(afterAccountId, limit, page);
+
+    try
+    {
+        auto& db = sdrs::database::DatabaseManager::getInstance();
+
+        db.executeRead([&](pqxx::nontransaction& txn) {
+            pqxx::result result = db.execPrepared(txn, FIND_FEATURE_PAGE, afterAccountId, limit);
+
+            page.resize(result.size());
+            for (size_t i = 0; i < result.size(); ++i)
+            {
+                const auto& row = result[i];
+                auto& out = page[i];
+                out.accountId = row["account_id"].as<int>();
+                out.borrowerId = row["borrower_id"].as<int>();
+                out.values[0] = row["age"].as<double>();
+                out.values[1] = row["monthly_income"].as<double>();
+                out.values[2] = row["debt_ratio"].as<double>();
+                out.values[3] = row["days_past_due"].as<double>();
+                out.values[4] = row["missed_payments"].as<double>();
+            }
+        });
+    }
+    catch (const pqxx::sql_error& e)
+    {
+        sdrs::utils::Logger::Error("[BorrowerSegmentRepo] SQL error in findFeaturePage: " + std::string(e.what()));
+        throw sdrs::exceptions::DatabaseException(e.what(), sdrs::constants::DatabaseErrorCode::QueryFailed);
+    }
+}
+
+void BorrowerSegmentRepository::saveSegments(const std::vector<BorrowerSegment>& segments, const std::string& algorithm)
+{
+    if (segments.empty()) return;
+    if (_useMock) return saveSegmentsMock(segments);
+
+    try
+    {
+        auto& db = sdrs::database::DatabaseManager::getInstance();
+
+        std::string accountIds = toArrayLiteral(segments, [](const BorrowerSegment& s) { return std::to_string(s.accountId); });
+        std::string borrowerIds = toArrayLiteral(segments, [](const BorrowerSegment& s) { return std::to_string(s.borrowerId); });
+        std::string clusterIds = toArrayLiteral(segments, [](const BorrowerSegment& s) { return std::to_string(s.clusterId); });
+        std::string distances = toArrayLiteral(segments, [](const BorrowerSegment& s) { return std::format("{:.4f}", s.clusterDistance); });
+
+        db.executeCommand([&](pqxx::work& txn) {
+            db.execPrepared(txn, DELETE_SEGMENTS, accountIds);
+
+            db.execPrepared(txn, INSERT_SEGMENTS, accountIds, borrowerIds, clusterIds, distances, algorithm);
+        });
+    }
+    catch (const pqxx::sql_error& e)
+    {
+        sdrs::utils::Logger::Error("[BorrowerSegmentRepo] SQL error in saveSegments: " + std::string(e.what()));
+        throw sdrs::exceptions::DatabaseException(e.what(), sdrs::constants::DatabaseErrorCode::QueryFailed);
+    }
+}
+
+// ============================================================================
+// Mock Mode Implementations
+// ============================================================================
+
+void BorrowerSegmentRepository::findFeaturePageMock(int afterAccountId, int limit, std::vector<SegmentFeatureRow>& page)
+{
+    page.clear();
+    for (const auto& row : _mockFeatures)
+    {
+        if (static_cast<int>(page.size()) >= limit) break;
+        if (row.accountId > afterAccountId)
+        {
+            page.push_back(row);
+        }
+    }
+}
+
+void BorrowerSegmentRepository::saveSegmentsMock(const std::vector<BorrowerSegment>& segments)
+{
+    for (const auto& segment : segments)
+    {
+        std::erase_if(_mockSegments, [&segment](const BorrowerSegment& existing) {
+            return existing.accountId == segment.accountId;
+        });
+        _mockSegments.push_back(segment);
+    }
+}
+
+} // namespace sdrs::risk
@@ -0,0 +1,164 @@
+// ModelRegistryRepository.cpp - PostgreSQL implementation
+
+#include "../../include/repositories/ModelRegistryRepository.h"
+#include "../../../common/include/utils/Logger.h"
+#include "../../../common/include/utils/Constants.h"
+#include "../../../common/include/exceptions/DatabaseException.h"
+
+namespace sdrs::risk
+{
+
+namespace
+{
+
+const sdrs::database::PreparedStatement FIND_ACTIVE("model_registry_find_active", R"(
+    SELECT model_id, model_name, model_type, version,
+           artifact_path, format_version, is_active
+    FROM ml_models
+    WHERE model_type = $1 AND is_active = true
+)");
+
+const sdrs::database::PreparedStatement DEACTIVATE_ACTIVE("model_registry_deactivate_active", "UPDATE ml_models SET is_active = false WHERE model_type = $1 AND is_active = true");
+
+const sdrs::database::PreparedStatement INSERT_ACTIVE("model_registry_insert_active", R"(
+    INSERT INTO ml_models (
+        model_name, model_type, version, hyperparameters,
+        artifact_path, format_version, is_active
+    ) VALUES ($1, $2, $3, $4::jsonb, $5, $6, true)
+    RETURNING model_id
+)");
+
+}
+
+// Static members for mock mode
+int ModelRegistryRepository::_nextMockId = 1;
+std::vector<ModelRecord> ModelRegistryRepository::_mockStorage;
+
+ModelRegistryRepository::ModelRegistryRepository(bool useMock)
+    : _useMock(useMock)
+{
+}
+
+std::optional<ModelRecord> ModelRegistryRepository::findActive(const std::string& modelType)
+{
+    if (_useMock) return findActiveMock(modelType);
+
+    try
+    {
+        auto& db = sdrs::database::DatabaseManager::getInstance();
+
+        return db.executeQuery([&](pqxx::work& txn) -> std::optional<ModelRecord> {
+            pqxx::result result = db.execPrepared(txn, FIND_ACTIVE, modelType);
+
+            if (result.empty())
+            {
+                return std::nullopt;
+            }
+
+            return mapRowToModelRecord(result[0]);
+        });
+    }
+    catch (const pqxx::sql_error& e)
+    {
+        sdrs::utils::Logger::Error("[ModelRegistryRepo] SQL error in findActive: " + std::string(e.what()));
+        throw sdrs::exceptions::DatabaseException(e.what(), sdrs::constants::DatabaseErrorCode::QueryFailed);
+    }
+}
+
+ModelRecord ModelRegistryRepository::registerActive(const ModelRecord& record, const std::string& hyperparametersJson)
+{
+    if (_useMock) return registerActiveMock(record);
+
+    try
+    {
+        auto& db = sdrs::database::DatabaseManager::getInstance();
+
+        return db.executeQuery([&](pqxx::work& txn) -> ModelRecord {
+            // Same transaction, so the unique_active_model index never sees two active rows
+            db.execPrepared(txn, DEACTIVATE_ACTIVE,
+                record.modelType
+            );
+
+            pqxx::result result = db.execPrepared(txn, INSERT_ACTIVE,
+                record.modelName,
+                record.modelType,
+                record.version,
+                hyperparametersJson,
+                record.artifactPath,
+                record.formatVersion
+            );
+
+            if (result.empty())
+            {
+                throw sdrs::exceptions::DatabaseException("Failed to register model", sdrs::constants::DatabaseErrorCode::QueryFailed);
+            }
+
+            ModelRecord created = record;
+            created.modelId = result[0]["model_id"].as<int>();
+            created.isActive = true;
+
+            sdrs::utils::Logger::Info("[ModelRegistryRepo] Registered active " + created.modelType
+                + " model ID: " + std::to_string(created.modelId));
+            return created;
+        });
+    }
+    catch (const pqxx::sql_error& e)
+    {
+        sdrs::utils::Logger::Error("[ModelRegistryRepo] SQL error in registerActive: " + std::string(e.what()));
+        throw sdrs::exceptions::DatabaseException(e.what(), sdrs::constants::DatabaseErrorCode::QueryFailed);
+    }
+}
+
+// ============================================================================
+// Mock Mode Implementations
+// ============================================================================
+
+std::optional<ModelRecord> ModelRegistryRepository::findActiveMock(const std::string& modelType)
+{
+    for (const auto& record : _mockStorage)
+    {
+        if (record.isActive && record.modelType == modelType)
+        {
+            return record;
+        }
+    }
+    return std::nullopt;
+}
+
+ModelRecord ModelRegistryRepository::registerActiveMock(const ModelRecord& record)
+{
+    for (auto& existing : _mockStorage)
+    {
+        if (existing.modelType == record.modelType)
+        {
+            existing.isActive = false;
+        }
+    }
+
+    ModelRecord created = record;
+    created.modelId = _nextMockId++;
+    created.isActive = true;
+    _mockStorage.push_back(created);
+
+    sdrs::utils::Logger::Info("[ModelRegistryRepo-Mock] Registered active " + created.modelType + " model");
+    return created;
+}
+
+// ============================================================================
+// Helper Methods
+// ============================================================================
+
+ModelRecord ModelRegistryRepository::mapRowToModelRecord(const pqxx::row& row)
+{
+    ModelRecord record;
+    record.modelId = row["model_id"].as<int>();
+    record.modelName = row["model_name"].as<std::string>();
+    record.modelType = row["model_type"].as<std::string>();
+    record.version = row["version"].as<std::string>();
+    record.artifactPath = row["artifact_path"].is_null() ? "" : row["artifact_path"].as<std::string>();
+    record.formatVersion = row["format_version"].is_null() ? 0 : row["format_version"].as<int>();
+    record.isActive = row["is_active"].as<bool>();
+    return record;
+}
+
+} // namespace sdrs::risk
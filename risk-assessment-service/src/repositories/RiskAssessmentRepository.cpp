@@ -5,6 +5,9 @@
 #include "../../../common/include/exceptions/DatabaseException.h"
 #include <nlohmann/json.hpp>
 #include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <ctime>
 
 namespace sdrs::risk
 {
@@ -13,6 +16,138 @@ namespace sdrs::risk
 int RiskAssessmentRepository::_nextMockId = 1;
 std::vector<RiskAssessment> RiskAssessmentRepository::_mockStorage;
 
+namespace
+{
+
+const sdrs::database::PreparedStatement CREATE("risk_assessment_create", R"(
+    INSERT INTO risk_assessments (
+        account_id, borrower_id, risk_score, risk_level,
+        algorithm_used, risk_factors, assessment_date
+    ) VALUES ($1, $2, $3, $4, $5, $6, $7)
+    RETURNING assessment_id, created_at
+)");
+
+const sdrs::database::PreparedStatement GET_BY_ID("risk_assessment_get_by_id", R"(
+    SELECT assessment_id, account_id, borrower_id, risk_score, risk_level,
+           algorithm_used, risk_factors, assessment_date, created_at
+    FROM risk_assessments
+    WHERE assessment_id = $1
+)");
+
+const sdrs::database::PreparedStatement GET_BY_ACCOUNT_ID("risk_assessment_get_by_account_id", R"(
+    SELECT assessment_id, account_id, borrower_id, risk_score, risk_level,
+           algorithm_used, risk_factors, assessment_date, created_at
+    FROM risk_assessments
+    WHERE account_id = $1
+    ORDER BY assessment_date DESC
+)");
+
+const sdrs::database::PreparedStatement GET_BY_BORROWER_ID("risk_assessment_get_by_borrower_id", R"(
+    SELECT assessment_id, account_id, borrower_id, risk_score, risk_level,
+           algorithm_used, risk_factors, assessment_date, created_at
+    FROM risk_assessments
+    WHERE borrower_id = $1
+    ORDER BY assessment_date DESC
+)");
+
+// Newest assessment of each listed account; $1 is an int array literal
+const sdrs::database::PreparedStatement GET_LATEST_BY_ACCOUNT_IDS("risk_assessment_get_latest_by_account_ids", R"(
+    SELECT DISTINCT ON (account_id)
+           assessment_id, account_id, borrower_id, risk_score, risk_level,
+           algorithm_used, risk_factors, assessment_date, created_at
+    FROM risk_assessments
+    WHERE account_id = ANY($1::int[])
+    ORDER BY account_id, assessment_date DESC, assessment_id DESC
+)");
+
+const sdrs::database::PreparedStatement GET_ALL("risk_assessment_get_all", R"(
+    SELECT assessment_id, account_id, borrower_id, risk_score, risk_level,
+           algorithm_used, risk_factors, assessment_date, created_at
+    FROM risk_assessments
+    ORDER BY assessment_date DESC
+)");
+
+const sdrs::database::PreparedStatement GET_BY_RISK_LEVEL("risk_assessment_get_by_risk_level", R"(
+    SELECT assessment_id, account_id, borrower_id, risk_score, risk_level,
+           algorithm_used, risk_factors, assessment_date, created_at
+    FROM risk_assessments
+    WHERE risk_level = $1
+    ORDER BY assessment_date DESC
+)");
+
+const sdrs::database::PreparedStatement GET_RECENT_ASSESSMENTS("risk_assessment_get_recent_assessments", R"(
+    SELECT assessment_id, account_id, borrower_id, risk_score, risk_level,
+           algorithm_used, risk_factors, assessment_date, created_at
+    FROM risk_assessments
+    ORDER BY assessment_date DESC
+    LIMIT $1
+)");
+
+const sdrs::database::PreparedStatement DELETE_BY_ID("risk_assessment_delete_by_id", "DELETE FROM risk_assessments WHERE assessment_id = $1");
+
+constexpr std::string_view algorithmName(AlgorithmUsed algorithm)
+{
+    return algorithm == AlgorithmUsed::RandomForest ? "RandomForest" : "RuleBase";
+}
+
+// risk_score is DECIMAL(5,3). Rounding can carry a score onto the next tier's lower bound
+// (0.3296 -> 0.330), which risk_level_matches_score would refuse for a Low row, so such
+// scores are truncated instead; the level itself always comes from the unrounded score.
+double storedScore(const RiskAssessment& assessment)
+{
+    double scaled = assessment.getRiskScore() * sdrs::constants::risk::RISK_SCORE_SCALE;
+    double rounded = std::round(scaled) / sdrs::constants::risk::RISK_SCORE_SCALE;
+    bool crossesTier = ((assessment.getRiskLevel() == sdrs::constants::RiskLevel::Low)
+        && (rounded >= sdrs::constants::risk::LOW_RISK_MAX))
+        || ((assessment.getRiskLevel() == sdrs::constants::RiskLevel::Medium)
+        && (rounded >= sdrs::constants::risk::MEDIUM_RISK_MAX));
+    return crossesTier ? std::floor(scaled) / sdrs::constants::risk::RISK_SCORE_SCALE : rounded;
+}
+
+// risk_factors JSONB text, written straight from the interned factors; replaces `out`
+void writeRiskFactorsJson(const RiskAssessment& assessment, std::string& out)
+{
+    out.assign("{");
+    char number[32];
+    for (size_t i = 0; i < NUM_RISK_FACTORS; ++i)
+    {
+        auto value = assessment.getRiskFactor(static_cast<RiskFactor>(i));
+        if (!value) continue;
+        if (out.size() > 1) out += ',';
+        out += '"';
+        out += RISK_FACTOR_NAMES[i];
+        out += "\":";
+        auto [end, ec] = std::to_chars(number, number + sizeof(number), *value);
+        out.append(number, end);
+    }
+    out += '}';
+}
+
+// assessment_date is a local TIMESTAMP; a batch is scored within a few seconds, so the
+// last conversion is reused while the second does not change
+class LocalTimeFormatter
+{
+private:
+    std::time_t _lastTime = -1;
+    char _text[20] = {};
+
+public:
+    const char* format(std::chrono::sys_seconds timestamp)
+    {
+        std::time_t time = std::chrono::system_clock::to_time_t(timestamp);
+        if (time != _lastTime)
+        {
+            std::tm local{};
+            localtime_r(&time, &local);
+            std::strftime(_text, sizeof(_text), "%Y-%m-%d %H:%M:%S", &local);
+            _lastTime = time;
+        }
+        return _text;
+    }
+};
+
+}
+
 RiskAssessmentRepository::RiskAssessmentRepository(std::shared_ptr<sdrs::database::DatabaseManager> dbManager)
     : _dbManager(dbManager), _useMockMode(dbManager == nullptr)
 {
@@ -33,36 +168,18 @@ RiskAssessment RiskAssessmentRepository::create(const RiskAssessment& assessment
     try
     {
         return _dbManager->executeQuery([&](pqxx::work& txn) -> RiskAssessment {
-            std::string sql = R"(
-                INSERT INTO risk_assessments (
-                    account_id, borrower_id, risk_score, risk_level,
-                    algorithm_used, risk_factors, assessment_date
-                ) VALUES ($1, $2, $3, $4, $5, $6, $7)
-                RETURNING assessment_id, created_at
-            )";
+            std::string factorsStr;
+            writeRiskFactorsJson(assessment, factorsStr);
+            LocalTimeFormatter timeFormatter;
             
-            // Convert risk_factors map to JSONB string
-            nlohmann::json factorsJson = assessment.getRiskFactors();
-            std::string factorsStr = factorsJson.dump();
-            
-            // Convert algorithm enum to string
-            std::string algorithmStr = (assessment.getAlgorithmUsed() == AlgorithmUsed::RandomForest) 
-                ? "RandomForest" : "RuleBase";
-            
-            // Convert timestamp to string
-            auto assessTime = std::chrono::system_clock::to_time_t(assessment.getAssessmentDate());
-            std::tm* tm = std::localtime(&assessTime);
-            char timeStr[20];
-            std::strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", tm);
-            
-            pqxx::result result = txn.exec_params(sql,
+            pqxx::result result = _dbManager->execPrepared(txn, CREATE,
                 assessment.getAccountId(),
                 assessment.getBorrowerId(),
-                assessment.getRiskScore(),
+                storedScore(assessment),
                 RiskAssessment::riskLevelToString(assessment.getRiskLevel()),
-                algorithmStr,
+                algorithmName(assessment.getAlgorithmUsed()),
                 factorsStr,
-                timeStr
+                timeFormatter.format(assessment.getAssessmentDate())
             );
             
             if (result.empty())
@@ -91,21 +208,114 @@ RiskAssessment RiskAssessmentRepository::create(const RiskAssessment& assessment
     }
 }
 
+size_t RiskAssessmentRepository::createBatch(std::span<const RiskAssessment> assessments, std::vector<size_t>* rejected)
+{
+    if (rejected) rejected->clear();
+    if (assessments.empty()) return 0;
+    if (_useMockMode) return createBatchMock(assessments);
+    
+    try
+    {
+        try
+        {
+            copyBatch(assessments);
+            sdrs::utils::Logger::Info("[RiskAssessmentRepo] Created " + std::to_string(assessments.size()) + " assessments");
+            return assessments.size();
+        }
+        catch (const pqxx::sql_error& e)
+        {
+            // A COPY is all or nothing, so one bad row would lose the whole batch
+            sdrs::utils::Logger::Warn("[RiskAssessmentRepo] COPY failed, writing " + std::to_string(assessments.size())
+                + " assessments row by row: " + std::string(e.what()));
+        }
+        
+        size_t written = insertEach(assessments, rejected);
+        sdrs::utils::Logger::Info("[RiskAssessmentRepo] Created " + std::to_string(written) + " of "
+            + std::to_string(assessments.size()) + " assessments");
+        return written;
+    }
+    catch (const pqxx::sql_error& e)
+    {
+        sdrs::utils::Logger::Error("[RiskAssessmentRepo] SQL error in createBatch: " + std::string(e.what()));
+        throw sdrs::exceptions::DatabaseException(e.what(), sdrs::constants::DatabaseErrorCode::QueryFailed);
+    }
+}
+
+void RiskAssessmentRepository::copyBatch(std::span<const RiskAssessment> assessments)
+{
+    _dbManager->executeCommand([&](pqxx::work& txn) {
+        // COPY FROM STDIN: rows are streamed, with no per-row statement or round trip
+        auto stream = pqxx::stream_to::table(txn, {"risk_assessments"}, {
+            "account_id", "borrower_id", "risk_score", "risk_level",
+            "algorithm_used", "risk_factors", "assessment_date"
+        });
+        
+        std::string factorsStr;
+        LocalTimeFormatter timeFormatter;
+        for (const auto& assessment : assessments)
+        {
+            writeRiskFactorsJson(assessment, factorsStr);
+            stream.write_values(
+                assessment.getAccountId(),
+                assessment.getBorrowerId(),
+                storedScore(assessment),
+                RiskAssessment::riskLevelToString(assessment.getRiskLevel()),
+                algorithmName(assessment.getAlgorithmUsed()),
+                factorsStr,
+                timeFormatter.format(assessment.getAssessmentDate())
+            );
+        }
+        stream.complete();
+    });
+}
+
+size_t RiskAssessmentRepository::insertEach(std::span<const RiskAssessment> assessments, std::vector<size_t>* rejected)
+{
+    size_t written = 0;
+    _dbManager->executeCommand([&](pqxx::work& txn) {
+        std::string factorsStr;
+        LocalTimeFormatter timeFormatter;
+        for (size_t i = 0; i < assessments.size(); ++i)
+        {
+            const auto& assessment = assessments[i];
+            writeRiskFactorsJson(assessment, factorsStr);
+            
+            // A savepoint per row: a refused row rolls back alone
+            pqxx::subtransaction savepoint(txn);
+            try
+            {
+                _dbManager->execPrepared(savepoint, CREATE,
+                    assessment.getAccountId(),
+                    assessment.getBorrowerId(),
+                    storedScore(assessment),
+                    RiskAssessment::riskLevelToString(assessment.getRiskLevel()),
+                    algorithmName(assessment.getAlgorithmUsed()),
+                    factorsStr,
+                    timeFormatter.format(assessment.getAssessmentDate())
+                );
+                savepoint.commit();
+                ++written;
+            }
+            catch (const pqxx::sql_error& e)
+            {
+                savepoint.abort();
+                sdrs::utils::Logger::Warn("[RiskAssessmentRepo] Skipped assessment for account "
+                    + std::to_string(assessment.getAccountId()) + ": " + std::string(e.what()));
+                if (rejected) rejected->push_back(i);
+            }
+        }
+    });
+    return written;
+}
+
 RiskAssessment RiskAssessmentRepository::getById(int assessmentId)
 {
     if (_useMockMode) return getByIdMock(assessmentId);
     
     try
     {
-        return _dbManager->executeQuery([&](pqxx::work& txn) -> RiskAssessment {
-            std::string sql = R"(
-                SELECT assessment_id, account_id, borrower_id, risk_score, risk_level,
-                       algorithm_used, risk_factors, assessment_date, created_at
-                FROM risk_assessments
-                WHERE assessment_id = $1
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, assessmentId);
+        return _dbManager->executeRead([&](pqxx::nontransaction& txn) -> RiskAssessment {
+            pqxx::result result = _dbManager->execPrepared(txn, GET_BY_ID, assessmentId);
             
             if (result.empty())
             {
@@ -131,16 +341,8 @@ std::vector<RiskAssessment> RiskAssessmentRepository::getByAccountId(int account
     
     try
     {
-        return _dbManager->executeQuery([&](pqxx::work& txn) -> std::vector<RiskAssessment> {
-            std::string sql = R"(
-                SELECT assessment_id, account_id, borrower_id, risk_score, risk_level,
-                       algorithm_used, risk_factors, assessment_date, created_at
-                FROM risk_assessments
-                WHERE account_id = $1
-                ORDER BY assessment_date DESC
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, accountId);
+        return _dbManager->executeRead([&](pqxx::nontransaction& txn) -> std::vector<RiskAssessment> {
+            pqxx::result result = _dbManager->execPrepared(txn, GET_BY_ACCOUNT_ID, accountId);
             
             std::vector<RiskAssessment> assessments;
             for (const auto& row : result)
@@ -164,16 +366,8 @@ std::vector<RiskAssessment> RiskAssessmentRepository::getByBorrowerId(int borrow
     
     try
     {
-        return _dbManager->executeQuery([&](pqxx::work& txn) -> std::vector<RiskAssessment> {
-            std::string sql = R"(
-                SELECT assessment_id, account_id, borrower_id, risk_score, risk_level,
-                       algorithm_used, risk_factors, assessment_date, created_at
-                FROM risk_assessments
-                WHERE borrower_id = $1
-                ORDER BY assessment_date DESC
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, borrowerId);
+        return _dbManager->executeRead([&](pqxx::nontransaction& txn) -> std::vector<RiskAssessment> {
+            pqxx::result result = _dbManager->execPrepared(txn, GET_BY_BORROWER_ID, borrowerId);
             
             std::vector<RiskAssessment> assessments;
             for (const auto& row : result)
@@ -191,21 +385,50 @@ std::vector<RiskAssessment> RiskAssessmentRepository::getByBorrowerId(int borrow
     }
 }
 
-std::vector<RiskAssessment> RiskAssessmentRepository::getAll()
+std::vector<RiskAssessment> RiskAssessmentRepository::getLatestByAccountIds(std::span<const int> accountIds)
 {
-    if (_useMockMode) return getAllMock();
+    if (_useMockMode) return getLatestByAccountIdsMock(accountIds);
+    if (accountIds.empty()) return {};
+    
+    std::string ids = "{";
+    for (int accountId : accountIds)
+    {
+        if (ids.size() > 1) ids += ',';
+        ids += std::to_string(accountId);
+    }
+    ids += '}';
     
     try
     {
+        // On the primary, like the change feed it pairs with
         return _dbManager->executeQuery([&](pqxx::work& txn) -> std::vector<RiskAssessment> {
-            std::string sql = R"(
-                SELECT assessment_id, account_id, borrower_id, risk_score, risk_level,
-                       algorithm_used, risk_factors, assessment_date, created_at
-                FROM risk_assessments
-                ORDER BY assessment_date DESC
-            )";
+            pqxx::result result = _dbManager->execPrepared(txn, GET_LATEST_BY_ACCOUNT_IDS, ids);
             
-            pqxx::result result = txn.exec_params(sql);
+            std::vector<RiskAssessment> assessments;
+            assessments.reserve(result.size());
+            for (const auto& row : result)
+            {
+                assessments.push_back(mapRowToRiskAssessment(row));
+            }
+            
+            return assessments;
+        });
+    }
+    catch (const pqxx::sql_error& e)
+    {
+        sdrs::utils::Logger::Error("[RiskAssessmentRepo] SQL error in getLatestByAccountIds: " + std::string(e.what()));
+        throw sdrs::exceptions::DatabaseException(e.what(), sdrs::constants::DatabaseErrorCode::QueryFailed);
+    }
+}
+
+std::vector<RiskAssessment> RiskAssessmentRepository::getAll()
+{
+    if (_useMockMode) return getAllMock();
+    
+    try
+    {
+        return _dbManager->executeRead([&](pqxx::nontransaction& txn) -> std::vector<RiskAssessment> {
+            pqxx::result result = _dbManager->execPrepared(txn, GET_ALL);
             
             std::vector<RiskAssessment> assessments;
             for (const auto& row : result)
@@ -240,16 +463,8 @@ std::vector<RiskAssessment> RiskAssessmentRepository::getByRiskLevel(sdrs::const
     
     try
     {
-        return _dbManager->executeQuery([&](pqxx::work& txn) -> std::vector<RiskAssessment> {
-            std::string sql = R"(
-                SELECT assessment_id, account_id, borrower_id, risk_score, risk_level,
-                       algorithm_used, risk_factors, assessment_date, created_at
-                FROM risk_assessments
-                WHERE risk_level = $1
-                ORDER BY assessment_date DESC
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, RiskAssessment::riskLevelToString(level));
+        return _dbManager->executeRead([&](pqxx::nontransaction& txn) -> std::vector<RiskAssessment> {
+            pqxx::result result = _dbManager->execPrepared(txn, GET_BY_RISK_LEVEL, RiskAssessment::riskLevelToString(level));
             
             std::vector<RiskAssessment> assessments;
             for (const auto& row : result)
@@ -282,16 +497,8 @@ std::vector<RiskAssessment> RiskAssessmentRepository::getRecentAssessments(int l
     
     try
     {
-        return _dbManager->executeQuery([&](pqxx::work& txn) -> std::vector<RiskAssessment> {
-            std::string sql = R"(
-                SELECT assessment_id, account_id, borrower_id, risk_score, risk_level,
-                       algorithm_used, risk_factors, assessment_date, created_at
-                FROM risk_assessments
-                ORDER BY assessment_date DESC
-                LIMIT $1
-            )";
-            
-            pqxx::result result = txn.exec_params(sql, limit);
+        return _dbManager->executeRead([&](pqxx::nontransaction& txn) -> std::vector<RiskAssessment> {
+            pqxx::result result = _dbManager->execPrepared(txn, GET_RECENT_ASSESSMENTS, limit);
             
             std::vector<RiskAssessment> assessments;
             for (const auto& row : result)
@@ -327,8 +534,7 @@ bool RiskAssessmentRepository::deleteById(int assessmentId)
     try
     {
         return _dbManager->executeQuery([&](pqxx::work& txn) -> bool {
-            std::string sql = "DELETE FROM risk_assessments WHERE assessment_id = $1";
-            pqxx::result result = txn.exec_params(sql, assessmentId);
+            pqxx::result result = _dbManager->execPrepared(txn, DELETE_BY_ID, assessmentId);
             return result.affected_rows() > 0;
         });
     }
@@ -354,6 +560,15 @@ RiskAssessment RiskAssessmentRepository::createMock(const RiskAssessment& assess
     return assessment;
 }
 
+size_t RiskAssessmentRepository::createBatchMock(std::span<const RiskAssessment> assessments)
+{
+    _mockStorage.insert(_mockStorage.end(), assessments.begin(), assessments.end());
+    _nextMockId += static_cast<int>(assessments.size());
+    
+    sdrs::utils::Logger::Info("[RiskAssessmentRepo-Mock] Created " + std::to_string(assessments.size()) + " assessments");
+    return assessments.size();
+}
+
 RiskAssessment RiskAssessmentRepository::getByIdMock(int assessmentId)
 {
     for (const auto& assessment : _mockStorage)
@@ -391,6 +606,23 @@ std::vector<RiskAssessment> RiskAssessmentRepository::getByAccountIdMock(int acc
     return filtered;
 }
 
+std::vector<RiskAssessment> RiskAssessmentRepository::getLatestByAccountIdsMock(std::span<const int> accountIds)
+{
+    std::vector<RiskAssessment> latest;
+    for (int accountId : accountIds)
+    {
+        // Storage is in insertion order, so the last match is the newest
+        auto found = std::find_if(_mockStorage.rbegin(), _mockStorage.rend(), [accountId](const RiskAssessment& assessment) {
+            return assessment.getAccountId() == accountId;
+        });
+        if (found != _mockStorage.rend())
+        {
+            latest.push_back(*found);
+        }
+    }
+    return latest;
+}
+
 std::vector<RiskAssessment> RiskAssessmentRepository::getByBorrowerIdMock(int borrowerId)
 {
     std::vector<RiskAssessment> filtered;
@@ -0,0 +1,615 @@
+#include "../include/algorithms/RandomForest.h"
+#include "../include/algorithms/KMeansClustering.h"
+#include "../include/models/RuleBasedScorer.h"
+#include "../include/models/AssessmentCache.h"
+#include "../../common/include/utils/Constants.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace sdrs::risk;
+using namespace sdrs::constants;
+using namespace sdrs::constants::risk;
+
+int failures = 0;
+
+void printResult(const std::string& testName, bool passed)
+{
+    std::cout << "[TEST] " << testName << " : " << (passed ? "PASSED" : "FAILED") << std::endl;
+    failures += passed ? 0 : 1;
+}
+
+void runTest(const std::string& testName, const std::function<bool()>& test)
+{
+    try
+    {
+        printResult(testName, test());
+    }
+    catch (const std::exception& ex)
+    {
+        printResult(testName, false);
+        std::cout << "  -> " << ex.what() << std::endl;
+    }
+}
+
+bool near(double a, double b, double tolerance = 1e-9)
+{
+    return std::abs(a - b) <= tolerance * std::max(1.0, std::abs(b));
+}
+
+// ---------------------------------------------------------------------------
+// Reference regression tree: every node re-sorts its rows and computes both sides'
+// variance from scratch. Same stopping rules and tie order as DecisionTree.
+// ---------------------------------------------------------------------------
+
+struct ReferenceNode
+{
+    int featureIndex = -1;
+    double threshold = 0.0;
+    double leafValue = 0.0;
+    std::unique_ptr<ReferenceNode> left;
+    std::unique_ptr<ReferenceNode> right;
+};
+
+double meanOf(const std::vector<int>& rows, const std::vector<double>& y)
+{
+    double sum = 0.0;
+    for (int row : rows) sum += y[row];
+    return sum / rows.size();
+}
+
+double varianceOf(const std::vector<int>& rows, const std::vector<double>& y)
+{
+    double mean = meanOf(rows, y);
+    double sum = 0.0;
+    for (int row : rows) sum += (y[row] - mean) * (y[row] - mean);
+    return sum / rows.size();
+}
+
+std::unique_ptr<ReferenceNode> buildReferenceTree(
+    const std::vector<std::vector<double>>& X,
+    const std::vector<double>& y,
+    const std::vector<int>& rows,
+    int depth,
+    int maxDepth,
+    int minSamplesSplit)
+{
+    auto node = std::make_unique<ReferenceNode>();
+    node->leafValue = meanOf(rows, y);
+
+    double variance = varianceOf(rows, y);
+    if ((depth >= maxDepth)
+        || (rows.size() < static_cast<size_t>(minSamplesSplit))
+        || (variance < RF_VARIANCE_EPSILON))
+    {
+        return node;
+    }
+
+    double bestGain = -std::numeric_limits<double>::infinity();
+    for (size_t f = 0; f < X[0].size(); ++f)
+    {
+        std::vector<double> values;
+        for (int row : rows) values.push_back(X[row][f]);
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+
+        for (size_t i = 0; i + 1 < values.size(); ++i)
+        {
+            double threshold = values[i] + (values[i + 1] - values[i]) * 0.5;
+            if (!(values[i] < threshold)) threshold = values[i + 1];
+
+            std::vector<int> left, right;
+            for (int row : rows) (X[row][f] < threshold ? left : right).push_back(row);
+
+            double gain = variance
+                - (left.size() * varianceOf(left, y) + right.size() * varianceOf(right, y)) / rows.size();
+            if (gain > bestGain)
+            {
+                bestGain = gain;
+                node->featureIndex = static_cast<int>(f);
+                node->threshold = threshold;
+            }
+        }
+    }
+
+    if ((node->featureIndex < 0)
+        || (bestGain <= 0.0))
+    {
+        node->featureIndex = -1;
+        return node;
+    }
+
+    std::vector<int> left, right;
+    for (int row : rows) (X[row][node->featureIndex] < node->threshold ? left : right).push_back(row);
+    node->left = buildReferenceTree(X, y, left, depth + 1, maxDepth, minSamplesSplit);
+    node->right = buildReferenceTree(X, y, right, depth + 1, maxDepth, minSamplesSplit);
+    return node;
+}
+
+double predictReference(const ReferenceNode* node, const std::vector<double>& features)
+{
+    while (node->featureIndex >= 0)
+    {
+        node = features[node->featureIndex] < node->threshold ? node->left.get() : node->right.get();
+    }
+    return node->leafValue;
+}
+
+// Rows on a noisy step surface; `levels` > 0 snaps every feature to that many integer values
+void makeRegressionData(size_t numRows, size_t numFeatures, int levels, uint32_t seed,
+    std::vector<std::vector<double>>& X, std::vector<double>& y)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    X.assign(numRows, std::vector<double>(numFeatures));
+    y.assign(numRows, 0.0);
+    for (size_t i = 0; i < numRows; ++i)
+    {
+        for (size_t f = 0; f < numFeatures; ++f)
+        {
+            X[i][f] = levels > 0 ? std::floor(unit(rng) * levels) : unit(rng);
+        }
+        double scale = levels > 0 ? levels : 1.0;
+        y[i] = (X[i][0] > 0.5 * scale ? 0.6 : 0.2) + (X[i][1] > 0.3 * scale ? 0.2 : 0.0) + unit(rng) * 0.1;
+    }
+}
+
+// Presorted split search with running sums (exact mode) against the reference tree, bootstrap
+// duplicates included; compared on the training rows, where both trees must partition alike
+bool testExactSplitMatchesReference()
+{
+    std::vector<std::vector<double>> X;
+    std::vector<double> y;
+    makeRegressionData(300, 4, 0, 11, X, y);
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> draws(0, 2);
+    std::vector<int> sampleCounts(X.size());
+    std::vector<int> rows;
+    for (size_t i = 0; i < X.size(); ++i)
+    {
+        sampleCounts[i] = draws(rng);
+        for (int c = 0; c < sampleCounts[i]; ++c) rows.push_back(static_cast<int>(i));
+    }
+
+    FeatureMatrix matrix;
+    matrix.build(X);
+    DecisionTree tree(6, 2);
+    tree.train(matrix, y, sampleCounts);
+    auto reference = buildReferenceTree(X, y, rows, 0, 6, 2);
+
+    for (int row : rows)
+    {
+        if (!near(tree.predict(X[row]), predictReference(reference.get(), X[row])))
+        {
+            return false;
+        }
+    }
+    return tree.isTrained();
+}
+
+// Histogram mode builds the larger child's histogram as parent minus sibling. With fewer distinct
+// values than bins the binning is lossless, so it must grow the same tree as the reference.
+bool testHistogramSplitMatchesReference()
+{
+    std::vector<std::vector<double>> X;
+    std::vector<double> y;
+    makeRegressionData(400, 4, 20, 23, X, y);
+
+    std::vector<int> rows(X.size());
+    for (size_t i = 0; i < rows.size(); ++i) rows[i] = static_cast<int>(i);
+
+    BinnedFeatures binned;
+    binned.build(X);
+    DecisionTree tree(8, 2);
+    tree.trainHistogram(binned, y, rows);
+    auto reference = buildReferenceTree(X, y, rows, 0, 8, 2);
+
+    for (int row : rows)
+    {
+        if (!near(tree.predict(X[row]), predictReference(reference.get(), X[row])))
+        {
+            return false;
+        }
+    }
+    return tree.isTrained();
+}
+
+// The compiled structure-of-arrays walk must agree with the pointer tree it was flattened from
+bool testCompiledForestMatchesTree()
+{
+    std::vector<std::vector<double>> X;
+    std::vector<double> y;
+    makeRegressionData(500, 5, 0, 31, X, y);
+
+    FeatureMatrix matrix;
+    matrix.build(X);
+    DecisionTree tree(8, 2);
+    tree.train(matrix, y, std::vector<int>(X.size(), 1));
+
+    FlatForest flat;
+    tree.flattenInto(flat);
+    FlatForestView view = flat.view();
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> unit(-0.1, 1.1);
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::vector<double> query(5);
+        for (double& value : query) value = unit(rng);
+        if (view.predictTree(0, query.data()) != tree.predict(query))
+        {
+            return false;
+        }
+    }
+    return view.numTrees == 1;
+}
+
+// Row-at-a-time and block-wise batch inference over the whole forest
+bool testForestBatchMatchesSingle()
+{
+    std::vector<std::vector<double>> X;
+    std::vector<double> y;
+    makeRegressionData(600, 5, 0, 41, X, y);
+
+    RandomForest forest(12, 6, 2);
+    forest.setSeed(17);
+    forest.setNumThreads(2);
+    forest.train(X, y);
+
+    std::vector<double> columns(X.size() * 5);
+    for (size_t i = 0; i < X.size(); ++i)
+    {
+        for (size_t f = 0; f < 5; ++f) columns[f * X.size() + i] = X[i][f];
+    }
+    auto batch = forest.predictBatch(columns, X.size());
+
+    for (size_t i = 0; i < X.size(); ++i)
+    {
+        if (!near(batch[i], forest.predict(X[i]), 1e-12))
+        {
+            return false;
+        }
+    }
+    return batch.size() == X.size();
+}
+
+// ---------------------------------------------------------------------------
+// KMeans: Hamerly-pruned assignment against plain Lloyd iterations
+// ---------------------------------------------------------------------------
+
+std::vector<std::vector<double>> makeBlobs(size_t numRows, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, 0.8);
+    const double centers[5][3] = {{0, 0, 0}, {4, 0, 1}, {0, 5, 2}, {3, 3, 5}, {6, 6, 0}};
+    std::vector<std::vector<double>> X(numRows, std::vector<double>(3));
+    for (size_t i = 0; i < numRows; ++i)
+    {
+        for (size_t f = 0; f < 3; ++f) X[i][f] = centers[i % 5][f] + noise(rng);
+    }
+    return X;
+}
+
+// One pass of train() assigns by full scan, so its centroids are where the pruned iterations
+// start; from there plain Lloyd with the same stopping rule must land on the same clustering
+bool checkLloydParity(const std::vector<std::vector<double>>& X, int k, int numThreads)
+{
+    KMeansClustering firstPass(k, 1);
+    firstPass.setSeed(99);
+    firstPass.setNumThreads(numThreads);
+    firstPass.train(X);
+
+    KMeansClustering model(k, KMEANS_MAX_ITERATIONS);
+    model.setSeed(99);
+    model.setNumThreads(numThreads);
+    model.train(X);
+
+    auto centroids = firstPass.getCentroids();
+    std::vector<int> labels(X.size());
+    int iterations = 1;
+    while (iterations < KMEANS_MAX_ITERATIONS)
+    {
+        for (size_t i = 0; i < X.size(); ++i)
+        {
+            double best = std::numeric_limits<double>::infinity();
+            for (int c = 0; c < k; ++c)
+            {
+                double distance = 0.0;
+                for (size_t f = 0; f < X[i].size(); ++f) distance += (X[i][f] - centroids[c][f]) * (X[i][f] - centroids[c][f]);
+                if (distance < best)
+                {
+                    best = distance;
+                    labels[i] = c;
+                }
+            }
+        }
+        ++iterations;
+
+        std::vector<std::vector<double>> sums(k, std::vector<double>(X[0].size(), 0.0));
+        std::vector<size_t> counts(k, 0);
+        for (size_t i = 0; i < X.size(); ++i)
+        {
+            ++counts[labels[i]];
+            for (size_t f = 0; f < X[i].size(); ++f) sums[labels[i]][f] += X[i][f];
+        }
+        double totalShift = 0.0;
+        for (int c = 0; c < k; ++c)
+        {
+            if (counts[c] == 0) continue;
+            double shift = 0.0;
+            for (size_t f = 0; f < sums[c].size(); ++f)
+            {
+                double updated = sums[c][f] / counts[c];
+                shift += (updated - centroids[c][f]) * (updated - centroids[c][f]);
+                centroids[c][f] = updated;
+            }
+            totalShift += std::sqrt(shift);
+        }
+        if (totalShift < KMEANS_TOLERANCE) break;
+    }
+
+    if ((model.getLabels() != labels)
+        || (model.getIterations() != iterations))
+    {
+        return false;
+    }
+    for (int c = 0; c < k; ++c)
+    {
+        for (size_t f = 0; f < centroids[c].size(); ++f)
+        {
+            if (!near(model.getCentroids()[c][f], centroids[c][f])) return false;
+        }
+    }
+    return true;
+}
+
+bool testHamerlyMatchesLloyd()
+{
+    return checkLloydParity(makeBlobs(3000, 7), 5, 1)
+        && checkLloydParity(makeBlobs(3000, 8), 8, 1);
+}
+
+bool testHamerlyMatchesLloydThreaded()
+{
+    return checkLloydParity(makeBlobs(20000, 9), 5, 4);
+}
+
+// ---------------------------------------------------------------------------
+// RuleBasedScorer: lookup tables against the rules written out as branches
+// ---------------------------------------------------------------------------
+
+double referenceRuleScore(const RiskFeatures& features)
+{
+    double score = 0.0;
+    if (features.daysPastDue >= DPD_HIGH_THRESHOLD) score += 0.40;
+    else if (features.daysPastDue >= DPD_MEDIUM_THRESHOLD) score += 0.30;
+    else if (features.daysPastDue >= DPD_LOW_THRESHOLD) score += 0.20;
+
+    score += std::min(0.30, features.numberOfMissedPayments * 0.10);
+    score += features.remainingAmount.getAmount() / (features.loanAmount.getAmount() + 1e-6) * 0.20;
+
+    double income = features.monthlyIncome.getAmount();
+    double payment = features.remainingAmount.getAmount() * (1.0 + features.interestRate) / 12.0;
+    if ((income <= 0)
+        && (features.remainingAmount.getAmount() > 0))
+    {
+        score += 0.35;
+    }
+    else if (income > 0)
+    {
+        double dti = payment / (income + 1e-6);
+        if (dti > 0.5) score += 0.25;
+        else if (dti > 0.35) score += 0.15;
+        else if (dti > 0.20) score += 0.10;
+        else if (dti > 0.10) score += 0.05;
+    }
+
+    if (features.age > 0)
+    {
+        if (features.age < 25) score += 0.10;
+        else if (features.age >= 65) score += 0.08;
+        else if ((features.age >= 35) && (features.age <= 50)) score -= 0.05;
+    }
+
+    if (features.accountAgeMonths > 0)
+    {
+        if (features.accountAgeMonths < 3) score += 0.10;
+        else if (features.accountAgeMonths < 6) score += 0.05;
+    }
+
+    switch (features.employmentStatus)
+    {
+    case EmploymentStatus::Employed:
+    case EmploymentStatus::Contract:
+    case EmploymentStatus::SelfEmployed:
+        break;
+    case EmploymentStatus::PartTime:
+    case EmploymentStatus::Student:
+        score += 0.05;
+        break;
+    default:
+        score += 0.10;
+    }
+
+    switch (features.accountStatus)
+    {
+    case AccountStatus::PaidOff:
+    case AccountStatus::Current:
+        break;
+    case AccountStatus::Partial:
+        score += 0.02;
+        break;
+    case AccountStatus::Settled:
+        score += 0.04;
+        break;
+    case AccountStatus::Delinquent:
+        score += 0.06;
+        break;
+    default:
+        score += 0.10;
+    }
+
+    return std::min(1.0, score);
+}
+
+RiskFeatures makeFeatures()
+{
+    RiskFeatures features;
+    features.accountId = 1;
+    features.borrowerId = 1;
+    features.loanAmount = sdrs::money::Money(1e8);
+    features.remainingAmount = sdrs::money::Money(6e7);
+    features.interestRate = 0.12;
+    features.monthlyIncome = sdrs::money::Money(2e7);
+    features.age = 40;
+    features.accountAgeMonths = 12;
+    return features;
+}
+
+// Every table edge, one step either side, scored alone and through scoreBatch
+bool testRuleScorerMatchesReferenceAtBoundaries()
+{
+    std::vector<RiskFeatures> cases;
+    auto add = [&cases](const std::function<void(RiskFeatures&)>& edit) {
+        RiskFeatures features = makeFeatures();
+        edit(features);
+        cases.push_back(features);
+    };
+
+    for (int threshold : {DPD_LOW_THRESHOLD, DPD_MEDIUM_THRESHOLD, DPD_HIGH_THRESHOLD, DPD_DEFAULT_THRESHOLD})
+    {
+        for (int delta : {-1, 0, 1}) add([&](RiskFeatures& f) { f.daysPastDue = threshold + delta; });
+    }
+    add([](RiskFeatures& f) { f.daysPastDue = 0; });
+    for (int missed = 0; missed <= 5; ++missed) add([&](RiskFeatures& f) { f.numberOfMissedPayments = missed; });
+    for (int age = -1; age <= rules::MAX_TABLE_AGE + 10; ++age) add([&](RiskFeatures& f) { f.age = age; });
+    for (int months = -1; months <= rules::MAX_TABLE_ACCOUNT_AGE + 3; ++months) add([&](RiskFeatures& f) { f.accountAgeMonths = months; });
+    for (int status = 0; status <= static_cast<int>(EmploymentStatus::None) + 1; ++status)
+    {
+        add([&](RiskFeatures& f) { f.employmentStatus = static_cast<EmploymentStatus>(status); });
+    }
+    for (int status = 0; status <= static_cast<int>(AccountStatus::Settled) + 1; ++status)
+    {
+        add([&](RiskFeatures& f) { f.accountStatus = static_cast<AccountStatus>(status); });
+    }
+
+    // Debt-to-income right at each tier, and with no income at all
+    double payment = 6e7 * (1.0 + 0.12) / 12.0;
+    for (double tier : {0.10, 0.20, 0.35, 0.50})
+    {
+        for (double scale : {1.0 - 1e-9, 1.0, 1.0 + 1e-9})
+        {
+            add([&](RiskFeatures& f) { f.monthlyIncome = sdrs::money::Money(payment / tier * scale); });
+        }
+    }
+    add([](RiskFeatures& f) { f.monthlyIncome = sdrs::money::Money(0.0); });
+    add([](RiskFeatures& f) { f.monthlyIncome = sdrs::money::Money(0.0); f.remainingAmount = sdrs::money::Money(0.0); });
+
+    // Worst case everywhere, so the 1.0 cap applies
+    add([](RiskFeatures& f) {
+        f.daysPastDue = 400; f.numberOfMissedPayments = 9; f.monthlyIncome = sdrs::money::Money(0.0);
+        f.age = 19; f.accountAgeMonths = 1;
+        f.employmentStatus = EmploymentStatus::Unemployed; f.accountStatus = AccountStatus::ChargedOff;
+    });
+
+    std::vector<double> batch(cases.size());
+    RuleBasedScorer::scoreBatch(cases, batch);
+    for (size_t i = 0; i < cases.size(); ++i)
+    {
+        double expected = referenceRuleScore(cases[i]);
+        if ((RuleBasedScorer::score(cases[i]) != expected)
+            || (batch[i] != expected))
+        {
+            std::cout << "  -> case " << i << ": expected " << expected << ", score " << RuleBasedScorer::score(cases[i])
+                << ", batch " << batch[i] << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// AssessmentCache: TTL, LRU eviction and key separation
+// ---------------------------------------------------------------------------
+
+AssessmentKey keyFor(int accountId, uint64_t modelVersion = 0)
+{
+    RiskFeatures features = makeFeatures();
+    features.accountId = accountId;
+    features.daysPastDue = accountId;
+    return AssessmentKey::make(features, modelVersion);
+}
+
+bool testCacheExpiresEntries()
+{
+    AssessmentCache cache(8, std::chrono::seconds(0), 1);
+    cache.insert(keyFor(1), CachedScore{0.4, AlgorithmUsed::RuleBase});
+    auto found = cache.find(keyFor(1));
+    auto stats = cache.getStats();
+    return (!found)
+        && (stats.expirations == 1)
+        && (stats.misses == 1)
+        && (stats.entries == 0);
+}
+
+bool testCacheEvictsLeastRecentlyUsed()
+{
+    AssessmentCache cache(2, std::chrono::seconds(60), 1);
+    cache.insert(keyFor(1), CachedScore{0.1, AlgorithmUsed::RuleBase});
+    cache.insert(keyFor(2), CachedScore{0.2, AlgorithmUsed::RuleBase});
+    bool touched = cache.find(keyFor(1)).has_value();  // 2 is now the least recently used
+    cache.insert(keyFor(3), CachedScore{0.3, AlgorithmUsed::RandomForest});
+
+    auto first = cache.find(keyFor(1));
+    auto third = cache.find(keyFor(3));
+    auto stats = cache.getStats();
+    return touched
+        && (!cache.find(keyFor(2)))
+        && (first && first->riskScore == 0.1)
+        && (third && third->algorithm == AlgorithmUsed::RandomForest)
+        && (stats.evictions == 1)
+        && (stats.entries == 2);
+}
+
+bool testCacheSeparatesModelVersions()
+{
+    AssessmentCache cache(8, std::chrono::seconds(60), 2);
+    cache.insert(keyFor(1, 7), CachedScore{0.7, AlgorithmUsed::RandomForest});
+    return (cache.find(keyFor(1, 7)).has_value())
+        && (!cache.find(keyFor(1, 8)))
+        && (!cache.find(keyFor(1, 0)));
+}
+
+bool testDisabledCacheStoresNothing()
+{
+    AssessmentCache cache(0, std::chrono::seconds(60), 4);
+    cache.insert(keyFor(1), CachedScore{0.5, AlgorithmUsed::RuleBase});
+    return (!cache.isEnabled())
+        && (!cache.find(keyFor(1)))
+        && (cache.getStats().entries == 0);
+}
+
+int main()
+{
+    runTest("Exact split matches reference tree", testExactSplitMatchesReference);
+    runTest("Histogram split matches reference tree", testHistogramSplitMatchesReference);
+    runTest("Compiled forest matches pointer tree", testCompiledForestMatchesTree);
+    runTest("Forest batch matches single-row predict", testForestBatchMatchesSingle);
+    runTest("Hamerly KMeans matches Lloyd", testHamerlyMatchesLloyd);
+    runTest("Hamerly KMeans matches Lloyd (threaded)", testHamerlyMatchesLloydThreaded);
+    runTest("Rule scorer matches reference at table boundaries", testRuleScorerMatchesReferenceAtBoundaries);
+    runTest("Cache expires entries past TTL", testCacheExpiresEntries);
+    runTest("Cache evicts least recently used", testCacheEvictsLeastRecentlyUsed);
+    runTest("Cache separates model versions", testCacheSeparatesModelVersions);
+    runTest("Cache with capacity 0 stores nothing", testDisabledCacheStoresNothing);
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}